@@ -0,0 +1,280 @@
+// Microbenchmark suite for cpptui.hpp. Runs headless (terminal output is
+// swallowed by a null stream buffer) and prints one stable, aligned line per
+// benchmark so runs can be diffed across library versions:
+//
+//   <name>  <time/op>  <throughput>
+//
+// Timing is best-of-3: each measurement repeats the workload until it has run
+// for at least ~100ms, and the fastest per-op time wins, which keeps results
+// repeatable on a loaded machine.
+
+#include <chrono>
+#include <cstdio>
+#include <functional>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "cpptui.hpp"
+
+using namespace cpptui;
+
+namespace {
+
+/// @brief Stream buffer that discards everything written to it
+class NullStreamBuf : public std::streambuf {
+ protected:
+  int_type overflow(int_type ch) override { return ch; }
+  std::streamsize xsputn(const char *, std::streamsize n) override { return n; }
+};
+
+/// @brief Run @p fn repeatedly and report the best per-op time
+/// @param name Benchmark name (stable across versions; used for diffing)
+/// @param units_per_op How many items one call to @p fn processes
+/// @param unit Unit label for the throughput column (e.g. "cell", "byte")
+/// @param fn One benchmark iteration
+void bench(const char *name, double units_per_op, const char *unit,
+           const std::function<void()> &fn) {
+  using clock = std::chrono::steady_clock;
+  constexpr double kMinBatchSec = 0.1;
+  constexpr int kReps = 3;
+
+  fn();  // Warmup
+
+  double best_ns = 0.0;
+  for (int rep = 0; rep < kReps; ++rep) {
+    long iters = 0;
+    auto start = clock::now();
+    double elapsed;
+    do {
+      fn();
+      ++iters;
+      elapsed = std::chrono::duration<double>(clock::now() - start).count();
+    } while (elapsed < kMinBatchSec);
+    double ns = elapsed * 1e9 / iters;
+    if (rep == 0 || ns < best_ns) best_ns = ns;
+  }
+
+  // time/op with an adaptive unit, throughput in millions of units/s
+  char time_buf[32];
+  if (best_ns < 1e3)
+    std::snprintf(time_buf, sizeof(time_buf), "%8.1f ns/op", best_ns);
+  else if (best_ns < 1e6)
+    std::snprintf(time_buf, sizeof(time_buf), "%8.2f us/op", best_ns / 1e3);
+  else
+    std::snprintf(time_buf, sizeof(time_buf), "%8.2f ms/op", best_ns / 1e6);
+
+  double per_s = units_per_op / best_ns * 1e9;
+  if (per_s >= 1e6)
+    std::printf("%-40s %s %10.2f M%s/s\n", name, time_buf, per_s / 1e6, unit);
+  else
+    std::printf("%-40s %s %10.0f %s/s\n", name, time_buf, per_s, unit);
+  std::fflush(stdout);
+}
+
+/// @brief Fill a buffer with a deterministic pattern; @p salt varies content
+void fill_pattern(Buffer &buf, int salt) {
+  Cell c;
+  for (int y = 0; y < buf.height(); ++y) {
+    for (int x = 0; x < buf.width(); ++x) {
+      c.content = std::string(1, (char)('a' + (x + y + salt) % 26));
+      c.fg_color = Color{(uint8_t)(x * 3), (uint8_t)(y * 5), 128};
+      buf.set(x, y, c);
+    }
+  }
+}
+
+// ---------------------------------------------------------------------------
+
+void bench_buffer() {
+  Buffer buf(200, 50);
+  Cell c;
+  c.content = "x";
+  c.fg_color = Color::Red();
+
+  bench("buffer_set_200x50", 200.0 * 50.0, "cell", [&] {
+    for (int y = 0; y < 50; ++y)
+      for (int x = 0; x < 200; ++x) buf.set(x, y, c);
+  });
+
+  Cell bg;
+  bg.bg_color = Color{30, 30, 30};
+  bench("buffer_clear_200x50", 200.0 * 50.0, "cell", [&] { buf.clear(bg); });
+}
+
+void bench_diff(Terminal &term) {
+  struct Case {
+    const char *name;
+    int w, h;
+    int change_every;  // 0 = identical buffers, 1 = every cell differs
+  };
+  const Case cases[] = {
+      {"diff_80x24_unchanged", 80, 24, 0},
+      {"diff_80x24_sparse", 80, 24, 20},
+      {"diff_80x24_full", 80, 24, 1},
+      {"diff_200x50_unchanged", 200, 50, 0},
+      {"diff_200x50_sparse", 200, 50, 20},
+      {"diff_200x50_full", 200, 50, 1},
+  };
+
+  for (const auto &cs : cases) {
+    Buffer cur(cs.w, cs.h), prev(cs.w, cs.h);
+    fill_pattern(cur, 0);
+    fill_pattern(prev, 0);
+    if (cs.change_every > 0) {
+      Cell c;
+      c.content = "#";
+      c.fg_color = Color::Green();
+      int i = 0;
+      for (int y = 0; y < cs.h; ++y)
+        for (int x = 0; x < cs.w; ++x)
+          if (i++ % cs.change_every == 0) cur.set(x, y, c);
+    }
+    bench(cs.name, (double)cs.w * cs.h, "cell",
+          [&] { term.render(cur, prev); });
+  }
+}
+
+void bench_shaping() {
+  std::string ascii, cjk, emoji;
+  while (ascii.size() < 1024) ascii += "The quick brown fox 0123456789. ";
+  while (cjk.size() < 1024) cjk += "端末の描画性能を測定する漢字混在文字列";
+  while (emoji.size() < 1024) emoji += "⚡🚀📊 status: ✅ load 🔥 ";
+
+  // Mutate a counter suffix every iteration so each call misses the
+  // shaping LRU and the UTF-8 decode + width lookup is actually timed;
+  // a fixed string would measure nothing but a cache hit
+  auto shape_fresh = [](const char *name, std::string text) {
+    size_t tag_at = text.size() - 8;
+    uint64_t counter = 0;
+    bench(name, (double)text.size(), "byte", [&, tag_at] {
+      char tag[16];
+      std::snprintf(tag, sizeof(tag), "%08llu",
+                    (unsigned long long)(counter++ % 100000000));
+      text.replace(tag_at, 8, tag, 8);
+      TextHelper::prepare_text_for_render(text);
+    });
+  };
+  shape_fresh("shape_ascii_1k", ascii + "00000000");
+  shape_fresh("shape_cjk_1k", cjk + "00000000");
+  shape_fresh("shape_emoji_1k", emoji + "00000000");
+
+  // Steady-state hit cost of the shaping LRU, for comparison
+  bench("shape_ascii_1k_cached", (double)ascii.size(), "byte",
+        [&] { TextHelper::prepare_text_for_render(ascii); });
+}
+
+void bench_vtparser() {
+  // Recorded mix of what a busy interactive session feeds the parser:
+  // plain typing, arrow keys, function keys, SGR mouse drags and a paste
+  std::string stream;
+  for (int i = 0; i < 32; ++i) {
+    stream += "hello world";
+    stream += "\033[A\033[B\033[C\033[D";  // Arrows
+    stream += "\033OP\033[15~";            // F1, F5
+    for (int m = 0; m < 8; ++m) {
+      stream += "\033[<32;" + std::to_string(10 + m) + ";5M";  // Mouse drag
+    }
+    stream += "\033[200~pasted text\033[201~";  // Bracketed paste
+  }
+
+  bench("vtparser_mixed_stream", (double)stream.size(), "byte", [&] {
+    VTParser parser;
+    for (char c : stream) parser.process(c);
+  });
+}
+
+/// @brief Build a representative slice of the widget_demo tree: labels,
+/// buttons, inputs, toggles, progress bars, a table and charts under borders
+std::shared_ptr<Vertical> make_demo_tree() {
+  auto root = std::make_shared<Vertical>();
+  root->add(std::make_shared<Label>("cpptui_bench demo tree",
+                                    Color{255, 200, 100}));
+
+  auto row = std::make_shared<Horizontal>();
+  row->fixed_height = 1;
+  for (int i = 0; i < 4; ++i) {
+    auto btn = std::make_shared<Button>("Button " + std::to_string(i), [] {});
+    btn->fixed_width = 12;
+    row->add(btn);
+  }
+  root->add(row);
+
+  auto inputs = std::make_shared<Horizontal>();
+  inputs->fixed_height = 3;
+  auto input = std::make_shared<Input>();
+  input->set_text("some input text");
+  inputs->add(input);
+  inputs->add(std::make_shared<ToggleSwitch>(StyledText("Toggle"), true));
+  root->add(inputs);
+
+  root->add(std::make_shared<ProgressBar>(0.6f));
+
+  auto table = std::make_shared<TableScrollable>();
+  table->columns = {StyledText("PID"), StyledText("Name"), StyledText("CPU"),
+                    StyledText("Mem")};
+  for (int i = 0; i < 40; ++i) {
+    table->add_row({std::to_string(1000 + i), "proc" + std::to_string(i),
+                    std::to_string(i % 100) + "%",
+                    std::to_string(i * 3) + "M"});
+  }
+  table->fixed_height = 12;
+  root->add(table);
+
+  auto charts = std::make_shared<Horizontal>();
+  auto chart = std::make_shared<LineChart>();
+  std::vector<double> vals;
+  for (int i = 0; i < 512; ++i) vals.push_back(50.0 + 40.0 * std::sin(i * .1));
+  chart->add_series(vals, "wave", Color::Cyan());
+  chart->min_val = 0;
+  chart->max_val = 100;
+  auto border = std::make_shared<Border>();
+  border->add(chart);
+  charts->add(border);
+
+  auto spark = std::make_shared<Sparkline>();
+  for (int i = 0; i < 128; ++i) spark->data.push_back((float)(i % 10) / 10.0f);
+  spark->fixed_height = 1;
+  charts->add(spark);
+  root->add(charts);
+
+  return root;
+}
+
+void bench_widget_tree() {
+  auto root = make_demo_tree();
+  Buffer buf(200, 50);
+  root->x = 0;
+  root->y = 0;
+  root->width = buf.width();
+  root->height = buf.height();
+
+  bench("widget_tree_layout_render_200x50", 1.0, "frame", [&] {
+    root->layout();
+    root->render(buf);
+  });
+}
+
+}  // namespace
+
+int main() {
+  std::printf("cpptui_bench %d.%d.%d (%dx%d reference sizes, best of 3)\n",
+              VERSION_MAJOR, VERSION_MINOR, VERSION_PATCH, 200, 50);
+
+  bench_buffer();
+  bench_shaping();
+  bench_vtparser();
+  bench_widget_tree();
+
+  // The terminal benchmarks construct a real Terminal (raw mode toggles and
+  // escape output) with std::cout swallowed so they run fine without a tty
+  NullStreamBuf null_buf;
+  std::streambuf *saved = std::cout.rdbuf(&null_buf);
+  {
+    Terminal term;
+    bench_diff(term);
+  }
+  std::cout.rdbuf(saved);
+
+  return 0;
+}
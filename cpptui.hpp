@@ -12,12 +12,17 @@
 #endif
 
 #include <algorithm>
+#include <atomic>
 #include <chrono>
 #include <cmath>
+#include <condition_variable>
 #include <csignal>
+#include <cstdarg>
+#include <cstdint>
 #include <cstdio>
 #include <cstdlib>
 #include <cstring>
+#include <deque>
 #include <filesystem>
 #include <functional>
 #include <iomanip>
@@ -25,10 +30,15 @@
 #include <memory>
 #include <mutex>
 #include <optional>
+#include <queue>
 #include <regex>
 #include <sstream>
 #include <string>
+#include <string_view>
+#include <thread>
+#include <typeinfo>
 #include <unordered_map>
+#include <unordered_set>
 #include <vector>
 
 namespace cpptui {
@@ -90,6 +100,13 @@ inline void handle_winch([[maybe_unused]] int sig) { g_resize_pending = 1; }
 
 inline std::function<void()> quit_app;
 
+// Damage tracking for partial redraws. Widgets report changed regions via
+// Widget::mark_dirty(); App::run accumulates the rectangles and re-renders
+// only widgets intersecting them, unless a full redraw has been requested
+// (resize, theme change, input dispatch, etc.).
+inline std::vector<Rect> g_damage_rects;
+inline bool g_full_damage = true;
+
 // Cross-thread wakeup mechanism for update()/post()
 #ifdef _WIN32
 inline HANDLE g_wakeup_event = NULL;
@@ -97,21 +114,567 @@ inline HANDLE g_wakeup_event = NULL;
 inline int g_wakeup_pipe[2] = {-1, -1};
 #endif
 
+/// @brief Lightweight frame profiler. App::run wraps each pipeline stage
+/// (posted callbacks, timers, layout, widget render, terminal diff + flush)
+/// in a FrameProfiler::Scope, Container::render attributes per-widget render
+/// cost, and Terminal::render reports diff volume. Records land in a
+/// fixed-size ring; on_record is a per-frame dump hook for shipping the
+/// numbers elsewhere. All instrumentation is skipped while enabled is false.
+class FrameProfiler {
+ public:
+  enum class Phase { Post = 0, Timers, Layout, Render, Diff, kCount };
+
+  static constexpr const char *phase_name(Phase p) {
+    constexpr const char *names[] = {"post", "timers", "layout", "render",
+                                     "diff"};
+    return names[(int)p];
+  }
+
+  struct FrameRecord {
+    double phase_ms[(int)Phase::kCount] = {};
+    double total_ms = 0.0;     ///< Sum of instrumented phases
+    int cells_diffed = 0;      ///< Cells emitted by the terminal diff
+    size_t bytes_written = 0;  ///< Bytes written to the terminal
+    bool partial = false;      ///< Damage-confined frame
+  };
+
+  /// @brief Per-widget render cost for the last frame
+  struct WidgetCost {
+    const void *widget = nullptr;
+    const char *type_name = "";
+    double ms = 0.0;
+  };
+
+  bool enabled = false;
+
+  /// @brief Dump hook: called with every completed frame record. Keep it
+  /// cheap; it runs on the UI thread at frame rate
+  std::function<void(const FrameRecord &)> on_record;
+
+  /// @brief RAII phase timer; no-op while the profiler is disabled
+  class Scope {
+   public:
+    Scope(FrameProfiler &p, Phase phase) : p_(p), phase_(phase) {
+      if (p_.enabled) start_ = std::chrono::steady_clock::now();
+    }
+    ~Scope() {
+      if (!p_.enabled) return;
+      auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                    std::chrono::steady_clock::now() - start_)
+                    .count();
+      p_.current_.phase_ms[(int)phase_] += (double)ns / 1e6;
+    }
+
+   private:
+    FrameProfiler &p_;
+    Phase phase_;
+    std::chrono::steady_clock::time_point start_;
+  };
+
+  void begin_frame() {
+    if (!enabled) return;
+    current_ = FrameRecord{};
+    widget_costs_.clear();
+  }
+
+  void end_frame(bool partial) {
+    if (!enabled) return;
+    current_.partial = partial;
+    current_.total_ms = 0.0;
+    for (double ms : current_.phase_ms) current_.total_ms += ms;
+
+    if (records_.size() < kRingSize) {
+      records_.push_back(current_);
+    } else {
+      records_[ring_head_] = current_;
+    }
+    ring_head_ = (ring_head_ + 1) % kRingSize;
+
+    last_complete_ = current_;
+    if (on_record) on_record(current_);
+  }
+
+  /// @brief Called by the terminal diff with this frame's output volume
+  void note_diff(int cells, size_t bytes) {
+    if (!enabled) return;
+    current_.cells_diffed += cells;
+    current_.bytes_written += bytes;
+  }
+
+  /// @brief Attribute render time to a widget (aggregated per frame)
+  void note_widget(const void *widget, const char *type_name, double ms) {
+    if (!enabled) return;
+    for (auto &wc : widget_costs_) {
+      if (wc.widget == widget) {
+        wc.ms += ms;
+        return;
+      }
+    }
+    widget_costs_.push_back({widget, type_name, ms});
+  }
+
+  /// @brief The most recently completed frame (the overlay renders mid-frame,
+  /// so the in-progress record is not yet meaningful)
+  const FrameRecord &last() const { return last_complete_; }
+  const std::vector<FrameRecord> &records() const { return records_; }
+  const std::vector<WidgetCost> &widget_costs() const { return widget_costs_; }
+
+  /// @brief Total-frame-time percentile over the ring (p in 0-100)
+  double percentile_ms(double p) const {
+    if (records_.empty()) return 0.0;
+    std::vector<double> totals;
+    totals.reserve(records_.size());
+    for (const auto &r : records_) totals.push_back(r.total_ms);
+    std::sort(totals.begin(), totals.end());
+    size_t idx = (size_t)(p / 100.0 * (totals.size() - 1) + 0.5);
+    return totals[std::min(idx, totals.size() - 1)];
+  }
+
+  /// @brief Serialize the record ring as a JSON array (machine-readable
+  /// counterpart of the overlay HUD)
+  std::string dump_json() const {
+    std::string out = "[";
+    for (size_t i = 0; i < records_.size(); ++i) {
+      // Oldest-first when the ring has wrapped
+      const FrameRecord &r =
+          records_[(ring_head_ + i) % records_.size()];
+      if (i) out += ",";
+      out += "{";
+      for (int ph = 0; ph < (int)Phase::kCount; ++ph) {
+        out += "\"";
+        out += phase_name((Phase)ph);
+        out += "_ms\":" + format_ms(r.phase_ms[ph]) + ",";
+      }
+      out += "\"total_ms\":" + format_ms(r.total_ms);
+      out += ",\"cells_diffed\":" + std::to_string(r.cells_diffed);
+      out += ",\"bytes_written\":" + std::to_string(r.bytes_written);
+      out += ",\"partial\":";
+      out += r.partial ? "true" : "false";
+      out += "}";
+    }
+    out += "]";
+    return out;
+  }
+
+  void clear() {
+    records_.clear();
+    widget_costs_.clear();
+    ring_head_ = 0;
+    current_ = FrameRecord{};
+    last_complete_ = FrameRecord{};
+  }
+
+ private:
+  static constexpr size_t kRingSize = 240;
+
+  static std::string format_ms(double ms) {
+    char buf[32];
+    std::snprintf(buf, sizeof(buf), "%.3f", ms);
+    return buf;
+  }
+
+  FrameRecord current_;
+  FrameRecord last_complete_;
+  std::vector<FrameRecord> records_;  // Ring, at most kRingSize entries
+  size_t ring_head_ = 0;              // Next slot to overwrite once full
+  std::vector<WidgetCost> widget_costs_;
+};
+
+inline FrameProfiler g_frame_profiler;
+
+// ========================================================================
+// Parallel Rendering
+// ========================================================================
+
+/// @brief Opt-in parallel subtree rendering. When enabled, containers
+/// whose visible children occupy pairwise-disjoint regions render each
+/// child into a per-child scratch buffer on the render pool and composite
+/// the results in child order, so split dashboards pay roughly the cost of
+/// their slowest pane instead of the sum. Enable via
+/// App::set_parallel_render(); defaults to off.
+inline bool g_parallel_render = false;
+
+/// @brief Set while a widget is rendering on a pool thread. Only the
+/// outermost container of a frame parallelizes; nested containers render
+/// serially inside their worker so the pool is never re-entered.
+inline thread_local bool g_in_parallel_render = false;
+
+/// @brief Lazily started worker pool for parallel subtree rendering.
+///
+/// A batch is one container's child renders for the current frame. run()
+/// publishes the batch, participates with the calling thread, and returns
+/// only once every task has finished, so no widget is ever touched by a
+/// worker outside the frame that scheduled it. Workers are created on
+/// first use, capped at the hardware thread count, and joined on teardown.
+class RenderPool {
+ public:
+  /// @brief Worker count cap; 0 sizes the pool from the hardware thread
+  /// count (leaving one core for the main loop)
+  int max_threads = 0;
+
+  ~RenderPool() { stop(); }
+
+  /// @brief Execute a batch of independent tasks; the calling thread
+  /// participates and the call returns when the whole batch is done
+  void run(std::vector<std::function<void()>> &tasks) {
+    if (tasks.empty()) return;
+    if (tasks.size() == 1) {
+      tasks[0]();
+      return;
+    }
+    ensure_workers(static_cast<int>(tasks.size()) - 1);
+    std::unique_lock<std::mutex> lock(mutex_);
+    batch_ = &tasks;
+    next_ = 0;
+    remaining_ = tasks.size();
+    ++generation_;
+    cv_.notify_all();
+    drain(lock);
+    done_cv_.wait(lock, [&] { return remaining_ == 0; });
+    batch_ = nullptr;
+  }
+
+  /// @brief Join all workers; subsequent run() calls restart them
+  void stop() {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      stop_ = true;
+    }
+    cv_.notify_all();
+    for (auto &t : threads_) {
+      if (t.joinable()) t.join();
+    }
+    threads_.clear();
+    std::lock_guard<std::mutex> lock(mutex_);
+    stop_ = false;
+  }
+
+ private:
+  void ensure_workers(int wanted) {
+    int cap = max_threads;
+    if (cap <= 0) {
+      unsigned hw = std::thread::hardware_concurrency();
+      cap = hw > 1 ? static_cast<int>(hw) - 1 : 0;
+    }
+    int target = std::min(wanted, cap);
+    std::lock_guard<std::mutex> lock(mutex_);
+    while (static_cast<int>(threads_.size()) < target) {
+      threads_.emplace_back([this] { worker(); });
+    }
+  }
+
+  /// @brief Claim and execute tasks until the batch is exhausted.
+  /// Expects the lock held; releases it around each task body.
+  void drain(std::unique_lock<std::mutex> &lock) {
+    while (batch_ && next_ < batch_->size()) {
+      std::function<void()> &task = (*batch_)[next_++];
+      lock.unlock();
+      task();
+      lock.lock();
+      if (--remaining_ == 0) done_cv_.notify_all();
+    }
+  }
+
+  void worker() {
+    g_in_parallel_render = true;  // Workers never re-enter the pool
+    uint64_t seen = 0;
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (true) {
+      cv_.wait(lock, [&] { return stop_ || generation_ != seen; });
+      if (stop_) return;
+      seen = generation_;
+      drain(lock);
+    }
+  }
+
+  std::mutex mutex_;
+  std::condition_variable cv_;
+  std::condition_variable done_cv_;
+  std::vector<std::thread> threads_;
+  std::vector<std::function<void()>> *batch_ = nullptr;
+  size_t next_ = 0;
+  size_t remaining_ = 0;
+  uint64_t generation_ = 0;
+  bool stop_ = false;
+};
+
+inline RenderPool g_render_pool;
+
 // ========================================================================
 // UTF-8 and Wide Character Utilities
 // ========================================================================
 
+// Forward declaration (defined after TextHelper below)
+inline int utf8_display_width(std::string_view s);
+
+/// @brief Codepoint class value: bits 0-1 hold the display width (0, 1
+/// or 2), bit 2 marks codepoints that extend the preceding grapheme
+/// cluster (combining marks, variation selectors, ZWJ, emoji modifiers).
+inline constexpr uint8_t kClusterExtend = 0x04;
+
+/// @brief Classification ranges, first match wins. This is the same
+/// policy the old hand-rolled comparison chain implemented (including
+/// the deliberate narrow overrides for glyphs widely rendered single
+/// cell), expressed as data so the lookup tables below can be generated
+/// from it at compile time.
+struct CodepointRange {
+  uint32_t lo;
+  uint32_t hi;
+  uint8_t val;
+};
+inline constexpr CodepointRange kCodepointRanges[] = {
+    // Control characters and soft hyphen
+    {0x0000, 0x001F, 0},
+    {0x007F, 0x009F, 0},
+    {0x00AD, 0x00AD, 0},
+    // Combining marks attach to the preceding base glyph
+    {0x0300, 0x036F, kClusterExtend},
+    {0x1AB0, 0x1AFF, kClusterExtend},
+    {0x1DC0, 0x1DFF, kClusterExtend},
+    {0x20D0, 0x20FF, kClusterExtend},
+    {0xFE20, 0xFE2F, kClusterExtend},
+    // Explicit narrow overrides for ambiguous symbols often used as icons:
+    // checkmark, ballot X, warning sign
+    {0x2713, 0x2713, 1},
+    {0x2717, 0x2717, 1},
+    {0x26A0, 0x26A0, 1},
+    // Zero-width characters; ZWNJ/ZWJ additionally join clusters
+    {0x200B, 0x200B, 0},
+    {0x200C, 0x200D, kClusterExtend},
+    {0x200E, 0x200F, 0},
+    {0x2028, 0x202F, 0},
+    {0x2060, 0x206F, 0},
+    {0xFEFF, 0xFEFF, 0},
+    // Variation selectors ride on their base character
+    {0xFE00, 0xFE0F, kClusterExtend},
+    {0xE0100, 0xE01EF, kClusterExtend},
+    // Emoji skin-tone modifiers: wide standalone, joining after emoji
+    {0x1F3FB, 0x1F3FF, 2 | kClusterExtend},
+    // Wide characters (CJK ideographs, Hangul, kana, emoji, symbols)
+    {0x4E00, 0x9FFF, 2},
+    {0x3400, 0x4DBF, 2},
+    {0x20000, 0x2A6DF, 2},
+    {0x2A700, 0x2B73F, 2},
+    {0x2B740, 0x2B81F, 2},
+    {0x2B820, 0x2CEAF, 2},
+    {0x2CEB0, 0x2EBEF, 2},
+    {0x30000, 0x3134F, 2},
+    {0xF900, 0xFAFF, 2},
+    {0x2F800, 0x2FA1F, 2},
+    {0xFF01, 0xFF60, 2},
+    {0xFFE0, 0xFFE6, 2},
+    {0xAC00, 0xD7AF, 2},
+    {0x1100, 0x11FF, 2},
+    {0x3130, 0x318F, 2},
+    {0xA960, 0xA97F, 2},
+    {0xD7B0, 0xD7FF, 2},
+    {0x3040, 0x309F, 2},
+    {0x30A0, 0x30FF, 2},
+    {0x31F0, 0x31FF, 2},
+    {0x3000, 0x303F, 2},
+    {0x3200, 0x32FF, 2},
+    {0x3300, 0x33FF, 2},
+    {0xFE30, 0xFE4F, 2},
+    {0x1F300, 0x1F9FF, 2},
+    {0x1FA00, 0x1FAFF, 2},
+    {0x2600, 0x26FF, 2},
+    {0x2700, 0x27BF, 2},
+};
+
+/// @brief Reference classifier: linear scan of the range list. Only used
+/// at compile time to generate the two-stage tables.
+constexpr uint8_t classify_codepoint_slow(uint32_t cp) {
+  for (const auto &r : kCodepointRanges) {
+    if (cp >= r.lo && cp <= r.hi) return r.val;
+  }
+  return 1;
+}
+
+/// @brief Two-stage compile-time lookup tables over the full codepoint
+/// space: stage1 maps a 256-codepoint block to a stage2 block, stage2
+/// holds the class byte per codepoint. Blocks not crossed by any range
+/// boundary collapse onto shared uniform blocks, so the whole structure
+/// is ~25KB of read-only data and a lookup is two dependent loads with
+/// no branches.
+struct CodepointTables {
+  static constexpr uint32_t kBlockCount = 0x110000 >> 8;
+  static constexpr uint32_t kMaxUnique = 160;
+
+  uint8_t stage1[kBlockCount] = {};
+  uint8_t stage2[kMaxUnique][256] = {};
+
+  constexpr CodepointTables() {
+    uint8_t uniform_block[8] = {};  // Class value -> stage2 index + 1
+    uint32_t unique = 0;
+    for (uint32_t b = 0; b < kBlockCount; ++b) {
+      uint32_t base = b << 8;
+      // A block is uniform unless some range boundary falls inside it
+      bool uniform = true;
+      for (const auto &r : kCodepointRanges) {
+        if ((r.lo > base && r.lo <= base + 0xFF) ||
+            (r.hi >= base && r.hi < base + 0xFF)) {
+          uniform = false;
+          break;
+        }
+      }
+      if (uniform) {
+        uint8_t val = classify_codepoint_slow(base);
+        if (uniform_block[val] == 0) {
+          if (unique >= kMaxUnique) throw "codepoint table overflow";
+          for (uint32_t i = 0; i < 256; ++i) stage2[unique][i] = val;
+          uniform_block[val] = static_cast<uint8_t>(unique + 1);
+          ++unique;
+        }
+        stage1[b] = uniform_block[val] - 1;
+      } else {
+        if (unique >= kMaxUnique) throw "codepoint table overflow";
+        for (uint32_t i = 0; i < 256; ++i) {
+          stage2[unique][i] = classify_codepoint_slow(base + i);
+        }
+        stage1[b] = static_cast<uint8_t>(unique);
+        ++unique;
+      }
+    }
+  }
+};
+
+inline constexpr CodepointTables kCodepointTables{};
+
+/// @brief O(1) branch-free class lookup (width bits plus extend flag)
+inline uint8_t codepoint_class(uint32_t cp) {
+  if (cp >= 0x110000) return 1;
+  return kCodepointTables.stage2[kCodepointTables.stage1[cp >> 8]][cp & 0xFF];
+}
+
+/// @brief Interning pool for grapheme clusters too long for inline CellGlyph
+/// storage. Entries are deduplicated and never freed; multi-codepoint
+/// clusters are rare enough that the pool stays tiny in practice. A deque
+/// keeps entry addresses stable across growth, so views handed out under
+/// the lock stay valid forever; the lock only serializes the deque's own
+/// bookkeeping against parallel render workers.
+inline std::deque<std::string> &glyph_pool() {
+  static std::deque<std::string> pool;
+  return pool;
+}
+
+inline std::mutex &glyph_pool_mutex() {
+  static std::mutex mutex;
+  return mutex;
+}
+
+/// @brief Intern a long grapheme cluster, returning its pool index
+inline uint32_t glyph_pool_intern(const std::string &s) {
+  static std::unordered_map<std::string, uint32_t> index;
+  std::lock_guard<std::mutex> lock(glyph_pool_mutex());
+  auto it = index.find(s);
+  if (it != index.end()) return it->second;
+  uint32_t id = static_cast<uint32_t>(glyph_pool().size());
+  glyph_pool().push_back(s);
+  index.emplace(s, id);
+  return id;
+}
+
+/// @brief Compact fixed-size glyph storage for a Cell or CharInfo.
+///
+/// Stores the UTF-8 bytes of one grapheme inline (up to 6 bytes, covering
+/// every single codepoint and common combining sequences) plus a cached
+/// display width. Rare longer clusters are interned in glyph_pool() and
+/// referenced by index. The struct is trivially copyable, so whole-buffer
+/// clears and copies are memset/memmove-class operations instead of
+/// thousands of per-cell heap string copies.
+struct CellGlyph {
+  static constexpr size_t kInlineCapacity = 6;
+  static constexpr uint8_t kPooled = 0xFF;  ///< len_ sentinel for pooled
+
+  CellGlyph() { assign(" ", 1); }
+  CellGlyph(const char *s) { assign(s, std::strlen(s)); }
+  CellGlyph(const std::string &s) { assign(s.data(), s.size()); }
+  CellGlyph(std::string_view s) { assign(s.data(), s.size()); }
+
+  CellGlyph &operator=(const char *s) {
+    assign(s, std::strlen(s));
+    return *this;
+  }
+  CellGlyph &operator=(const std::string &s) {
+    assign(s.data(), s.size());
+    return *this;
+  }
+  CellGlyph &operator=(std::string_view s) {
+    assign(s.data(), s.size());
+    return *this;
+  }
+
+  /// @brief View of the stored UTF-8 bytes (valid until the next assignment)
+  std::string_view view() const {
+    if (len_ == kPooled) {
+      // Pool entries are immutable with stable addresses; the lock only
+      // guards the deque's bookkeeping against a concurrent intern
+      std::lock_guard<std::mutex> lock(glyph_pool_mutex());
+      return glyph_pool()[pool_index()];
+    }
+    return {bytes_, len_};
+  }
+  operator std::string_view() const { return view(); }
+
+  /// @brief Copy the stored glyph into a std::string
+  std::string str() const { return std::string(view()); }
+
+  /// @brief True if no glyph bytes are stored (e.g. wide-char continuation)
+  bool empty() const { return len_ == 0; }
+
+  /// @brief Cached display width of the glyph (0, 1, or 2)
+  int display_width() const { return width_; }
+
+  bool operator==(const CellGlyph &other) const {
+    // Pooled entries are deduplicated, so index equality is value equality;
+    // inline bytes are zero-padded, so a plain field compare suffices
+    return len_ == other.len_ && width_ == other.width_ &&
+           std::memcmp(bytes_, other.bytes_, kInlineCapacity) == 0;
+  }
+  bool operator!=(const CellGlyph &other) const { return !(*this == other); }
+
+  bool operator==(std::string_view s) const { return view() == s; }
+  bool operator!=(std::string_view s) const { return view() != s; }
+  bool operator==(const char *s) const { return view() == s; }
+  bool operator!=(const char *s) const { return view() != s; }
+
+ private:
+  char bytes_[kInlineCapacity] = {};  ///< Inline UTF-8 (or pool index)
+  uint8_t len_ = 0;                   ///< Byte count, or kPooled sentinel
+  uint8_t width_ = 0;                 ///< Cached display width
+
+  uint32_t pool_index() const {
+    uint32_t idx;
+    std::memcpy(&idx, bytes_, sizeof(idx));
+    return idx;
+  }
+
+  void assign(const char *data, size_t n) {
+    std::memset(bytes_, 0, kInlineCapacity);
+    if (n <= kInlineCapacity) {
+      std::memcpy(bytes_, data, n);
+      len_ = static_cast<uint8_t>(n);
+    } else {
+      uint32_t idx = glyph_pool_intern(std::string(data, n));
+      std::memcpy(bytes_, &idx, sizeof(idx));
+      len_ = kPooled;
+    }
+    width_ = static_cast<uint8_t>(
+        utf8_display_width(std::string_view(data, n)));
+  }
+};
+
 /// @brief Helper structure containing pre-processed character information
 struct CharInfo {
-  std::string content;  ///< The UTF-8 string content of the character
-  int display_width;    ///< The display width (0, 1, or 2)
+  CellGlyph content = std::string_view("");  ///< The UTF-8 character content
+  int display_width = 0;  ///< The display width (0, 1, or 2)
 };
 
 /// @brief Centralized helper for text manipulation, UTF-8 processing, and
 /// selection logic
 struct TextHelper {
   /// @brief Decode a UTF-8 character from a string
-  static bool utf8_decode_codepoint(const std::string &s, size_t pos,
+  static bool utf8_decode_codepoint(std::string_view s, size_t pos,
                                     uint32_t &out_codepoint, int &out_len) {
     if (pos >= s.size()) return false;
 
@@ -145,79 +708,69 @@ struct TextHelper {
     return true;
   }
 
-  /// @brief Get display width of a codepoint
+  /// @brief Get display width of a codepoint (two-stage table lookup)
   static int char_display_width(uint32_t codepoint) {
-    if (codepoint == 0 || codepoint < 0x20 || codepoint == 0x7F ||
-        (codepoint >= 0x80 && codepoint < 0xA0))
-      return 0;
-    if (codepoint == 0x00AD) return 0;  // Soft hyphen
-
-    // Combining marks
-    if ((codepoint >= 0x0300 && codepoint <= 0x036F) ||
-        (codepoint >= 0x1AB0 && codepoint <= 0x1AFF) ||
-        (codepoint >= 0x1DC0 && codepoint <= 0x1DFF) ||
-        (codepoint >= 0x20D0 && codepoint <= 0x20FF) ||
-        (codepoint >= 0xFE20 && codepoint <= 0xFE2F))
-      return 0;
-
-    // Explicit Narrow Overrides for ambiguous symbols often used as icons
-    // Checkmark (2713), Ballot X (2717), Warning Sign (26A0)
-    if (codepoint == 0x2713 || codepoint == 0x2717 || codepoint == 0x26A0)
-      return 1;
-
-    // Zero-width
-    if ((codepoint >= 0x200B && codepoint <= 0x200F) ||
-        (codepoint >= 0x2028 && codepoint <= 0x202F) ||
-        (codepoint >= 0x2060 && codepoint <= 0x206F) || codepoint == 0xFEFF)
-      return 0;
-
-    if ((codepoint >= 0xFE00 && codepoint <= 0xFE0F) ||
-        (codepoint >= 0xE0100 && codepoint <= 0xE01EF))
-      return 0;
-
-    // Wide characters
-    if ((codepoint >= 0x4E00 && codepoint <= 0x9FFF) ||
-        (codepoint >= 0x3400 && codepoint <= 0x4DBF) ||
-        (codepoint >= 0x20000 && codepoint <= 0x2A6DF) ||
-        (codepoint >= 0x2A700 && codepoint <= 0x2B73F) ||
-        (codepoint >= 0x2B740 && codepoint <= 0x2B81F) ||
-        (codepoint >= 0x2B820 && codepoint <= 0x2CEAF) ||
-        (codepoint >= 0x2CEB0 && codepoint <= 0x2EBEF) ||
-        (codepoint >= 0x30000 && codepoint <= 0x3134F) ||
-        (codepoint >= 0xF900 && codepoint <= 0xFAFF) ||
-        (codepoint >= 0x2F800 && codepoint <= 0x2FA1F) ||
-        (codepoint >= 0xFF01 && codepoint <= 0xFF60) ||
-        (codepoint >= 0xFFE0 && codepoint <= 0xFFE6) ||
-        (codepoint >= 0xAC00 && codepoint <= 0xD7AF) ||
-        (codepoint >= 0x1100 && codepoint <= 0x11FF) ||
-        (codepoint >= 0x3130 && codepoint <= 0x318F) ||
-        (codepoint >= 0xA960 && codepoint <= 0xA97F) ||
-        (codepoint >= 0xD7B0 && codepoint <= 0xD7FF) ||
-        (codepoint >= 0x3040 && codepoint <= 0x309F) ||
-        (codepoint >= 0x30A0 && codepoint <= 0x30FF) ||
-        (codepoint >= 0x31F0 && codepoint <= 0x31FF) ||
-        (codepoint >= 0x3000 && codepoint <= 0x303F) ||
-        (codepoint >= 0x3200 && codepoint <= 0x32FF) ||
-        (codepoint >= 0x3300 && codepoint <= 0x33FF) ||
-        (codepoint >= 0xFE30 && codepoint <= 0xFE4F) ||
-        (codepoint >= 0x1F300 && codepoint <= 0x1F9FF) ||
-        (codepoint >= 0x1FA00 && codepoint <= 0x1FAFF) ||
-        (codepoint >= 0x2600 && codepoint <= 0x26FF) ||
-        (codepoint >= 0x2700 && codepoint <= 0x27BF)) {
-      return 2;
-    }
-    return 1;
-  }
-
-  /// @brief Calculate total display width of a string
-  static int utf8_display_width(const std::string &s) {
+    return codepoint_class(codepoint) & 0x03;
+  }
+
+  /// @brief True if the codepoint extends the preceding grapheme cluster
+  /// (combining mark, variation selector, ZWNJ/ZWJ, emoji modifier)
+  static bool is_cluster_extend(uint32_t codepoint) {
+    return (codepoint_class(codepoint) & kClusterExtend) != 0;
+  }
+
+  /// @brief Decode the grapheme cluster starting at @p pos: total byte
+  /// length and display width. Combining marks, variation selectors, ZWJ
+  /// sequences, emoji modifiers, and regional-indicator pairs all join
+  /// their base so a cluster occupies a single cell and the diff cursor
+  /// advances correctly.
+  /// @return false if @p pos does not start a valid UTF-8 sequence
+  static bool utf8_decode_cluster(std::string_view s, size_t pos,
+                                  size_t &out_len, int &out_width) {
+    uint32_t cp;
+    int len;
+    if (!utf8_decode_codepoint(s, pos, cp, len)) return false;
+    size_t end = pos + len;
+    int width = char_display_width(cp);
+    bool base_is_ri = cp >= 0x1F1E6 && cp <= 0x1F1FF;  // Regional indicator
+    bool after_zwj = false;
+    while (end < s.size()) {
+      uint32_t next;
+      int next_len;
+      if (!utf8_decode_codepoint(s, end, next, next_len)) break;
+      bool ri_pair = base_is_ri && next >= 0x1F1E6 && next <= 0x1F1FF;
+      if (!after_zwj && !ri_pair && !is_cluster_extend(next)) break;
+      end += next_len;
+      if (ri_pair) {
+        // Two regional indicators form one flag cluster, rendered wide
+        width = 2;
+        base_is_ri = false;
+        continue;
+      }
+      if (after_zwj) {
+        // The codepoint after a ZWJ is a new base in the same cluster
+        after_zwj = false;
+        int w = char_display_width(next);
+        if (w > width) width = w;
+        continue;
+      }
+      if (next == 0xFE0F && width < 2) width = 2;  // Emoji presentation
+      after_zwj = next == 0x200D;
+    }
+    out_len = end - pos;
+    out_width = width;
+    return true;
+  }
+
+  /// @brief Calculate total display width of a string (cluster-aware)
+  static int utf8_display_width(std::string_view s) {
     int width = 0;
     size_t pos = 0;
     while (pos < s.size()) {
-      uint32_t codepoint;
-      int len;
-      if (utf8_decode_codepoint(s, pos, codepoint, len)) {
-        width += char_display_width(codepoint);
+      size_t len;
+      int w;
+      if (utf8_decode_cluster(s, pos, len, w)) {
+        width += w;
         pos += len;
       } else {
         pos++;
@@ -236,26 +789,73 @@ struct TextHelper {
     return false;
   }
 
-  /// @brief Pre-process text into characters for rendering
+  /// @brief Pre-process text into characters for rendering.
+  /// Served from the shared shaping cache; CharInfo is trivially copyable,
+  /// so a hit is a flat memcpy instead of a UTF-8 decode pass.
   static std::vector<CharInfo> prepare_text_for_render(
       const std::string &text) {
-    std::vector<CharInfo> chars;
+    return *prepare_text_cached(text);
+  }
+
+  /// @brief Cached text shaping: returns a shared immutable prepared-glyph
+  /// run for the given text. Results live in a bounded LRU keyed by the
+  /// source string and are only recomputed when the text actually changes,
+  /// so steady-state frames do zero UTF-8 re-decoding. Callers that do not
+  /// need to mutate the result should prefer this over
+  /// prepare_text_for_render to also skip the copy. The cache is shared
+  /// across parallel render workers; even hits move the LRU clock, so the
+  /// whole lookup runs under one (rarely contended) lock.
+  static std::shared_ptr<const std::vector<CharInfo>> prepare_text_cached(
+      const std::string &text) {
+    struct CacheEntry {
+      std::shared_ptr<const std::vector<CharInfo>> chars;
+      uint64_t last_used;
+    };
+    static std::unordered_map<std::string, CacheEntry> cache;
+    static uint64_t use_clock = 0;
+    static std::mutex mutex;
+    std::lock_guard<std::mutex> lock(mutex);
+
+    ++use_clock;
+    auto it = cache.find(text);
+    if (it != cache.end()) {
+      it->second.last_used = use_clock;
+      return it->second.chars;
+    }
+
+    // Bound the cache: when full, evict the least-recently-used half.
+    // Shared ownership means eviction can never invalidate a result a
+    // caller is still holding.
+    if (cache.size() >= 4096) {
+      std::vector<uint64_t> stamps;
+      stamps.reserve(cache.size());
+      for (const auto &e : cache) stamps.push_back(e.second.last_used);
+      std::nth_element(stamps.begin(), stamps.begin() + stamps.size() / 2,
+                       stamps.end());
+      uint64_t cutoff = stamps[stamps.size() / 2];
+      for (auto ev = cache.begin(); ev != cache.end();) {
+        ev = (ev->second.last_used <= cutoff) ? cache.erase(ev) : std::next(ev);
+      }
+    }
+
+    auto chars = std::make_shared<std::vector<CharInfo>>();
     size_t pos = 0;
     while (pos < text.size()) {
-      uint32_t codepoint;
-      int byte_len;
-      if (utf8_decode_codepoint(text, pos, codepoint, byte_len)) {
+      size_t byte_len;
+      int width;
+      if (utf8_decode_cluster(text, pos, byte_len, width)) {
         CharInfo ci;
-        ci.content = text.substr(pos, byte_len);
-        ci.display_width = char_display_width(codepoint);
-        if (ci.display_width < 0) ci.display_width = 0;
-        chars.push_back(ci);
+        ci.content = std::string_view(text).substr(pos, byte_len);
+        ci.display_width = width < 0 ? 0 : width;
+        chars->push_back(ci);
         pos += byte_len;
       } else {
         pos++;
       }
     }
-    return chars;
+
+    auto entry = cache.emplace(text, CacheEntry{std::move(chars), use_clock});
+    return entry.first->second.chars;
   }
 
   /// @brief Convert visual X to character index
@@ -270,14 +870,15 @@ struct TextHelper {
     return (int)chars.size();
   }
 
-  /// @brief Convert character index to byte offset
+  /// @brief Convert character index to byte offset. Steps by grapheme
+  /// cluster so indices agree with prepare_text_for_render.
   static size_t char_to_byte_pos(const std::string &text, size_t char_idx) {
     size_t pos = 0;
     size_t count = 0;
     while (pos < text.size() && count < char_idx) {
-      uint32_t cp;
-      int len;
-      if (utf8_decode_codepoint(text, pos, cp, len)) {
+      size_t len;
+      int w;
+      if (utf8_decode_cluster(text, pos, len, w)) {
         pos += len;
         count++;
       } else {
@@ -322,14 +923,16 @@ struct TextHelper {
 
   // --- New Helper Methods ---
 
-  /// @brief Count number of UTF-8 codepoints in a string
+  /// @brief Count the character units in a string. Counts grapheme
+  /// clusters, not raw codepoints, so the result matches the index space
+  /// of prepare_text_for_render and char_to_byte_pos.
   static size_t count_codepoints(const std::string &text) {
     size_t count = 0;
     size_t pos = 0;
     while (pos < text.size()) {
-      uint32_t cp;
-      int len;
-      if (utf8_decode_codepoint(text, pos, cp, len)) {
+      size_t len;
+      int w;
+      if (utf8_decode_cluster(text, pos, len, w)) {
         count++;
         pos += len;
       } else {
@@ -480,14 +1083,14 @@ struct SelectionState {
 };
 
 // Backward compatibility wrappers
-inline bool utf8_decode_codepoint(const std::string &s, size_t pos,
+inline bool utf8_decode_codepoint(std::string_view s, size_t pos,
                                   uint32_t &out_codepoint, int &out_len) {
   return TextHelper::utf8_decode_codepoint(s, pos, out_codepoint, out_len);
 }
 inline int char_display_width(uint32_t codepoint) {
   return TextHelper::char_display_width(codepoint);
 }
-inline int utf8_display_width(const std::string &s) {
+inline int utf8_display_width(std::string_view s) {
   return TextHelper::utf8_display_width(s);
 }
 inline bool is_word_char(uint32_t cp) { return TextHelper::is_word_char(cp); }
@@ -503,6 +1106,10 @@ inline int utf8_char_byte_length(const std::string &s, size_t pos) {
 inline std::vector<CharInfo> prepare_text_for_render(const std::string &text) {
   return TextHelper::prepare_text_for_render(text);
 }
+inline std::shared_ptr<const std::vector<CharInfo>> prepare_text_cached(
+    const std::string &text) {
+  return TextHelper::prepare_text_cached(text);
+}
 /// @brief Base64 encoding for clipboard operations (OSC 52)
 /// @param input The string to encode
 /// @return Base64 encoded string
@@ -677,6 +1284,7 @@ enum class EventType {
   Resize,  ///< Terminal resize
   Quit,    ///< Application quit request
   Paste,   ///< Paste from clipboard (bracketed paste)
+  Text,    ///< Batched plain-text run (from chunked input parsing)
   Wakeup   ///< Cross-thread wakeup (from update()/post())
 };
 
@@ -688,7 +1296,7 @@ struct Event {
   int y = 0;                         ///< Y coordinate for Mouse events
   int button = -1;                   ///< Raw button code for Mouse events
   int click_count = 0;     ///< Number of clicks (1=single, 2=double, 3=triple)
-  std::string paste_text;  ///< Text content for Paste events
+  std::string paste_text;  ///< Text payload for Paste and Text events
 
   // Helpers for standard 1003 mouse tracking encoding
   bool mouse_left() const { return (button & 3) == 0 && (button & 64) == 0; }
@@ -759,6 +1367,10 @@ struct Event {
   // Type checking helpers
   bool is_key_event() const { return type == EventType::Key; }
   bool is_mouse_event() const { return type == EventType::Mouse; }
+  /// @brief Event carrying a paste_text payload (Paste or batched Text run)
+  bool is_text_event() const {
+    return type == EventType::Paste || type == EventType::Text;
+  }
 
   // Additional key helpers
   bool is_space() const { return key == ' ' || key == 32; }
@@ -814,6 +1426,19 @@ struct Color {
   /// @param bg The background color
   /// @return Black or White, whichever provides better contrast
   static Color contrast_color(const Color &bg) {
+    // The gamma math below costs three pow() calls, and hot widgets ask
+    // for the same handful of backgrounds every frame. Memoize through a
+    // small direct-mapped table; key and result share one atomic word so
+    // parallel render workers race benignly (worst case: a recompute).
+    static std::atomic<uint32_t> memo[256] = {};
+    uint32_t key = (static_cast<uint32_t>(bg.r) << 16) |
+                   (static_cast<uint32_t>(bg.g) << 8) | bg.b;
+    std::atomic<uint32_t> &slot = memo[(key * 2654435761u) >> 24];
+    uint32_t packed = slot.load(std::memory_order_relaxed);
+    if ((packed >> 2) == key && (packed & 1)) {
+      return (packed & 2) ? Black() : White();
+    }
+
     // Proper sRGB to linear conversion with gamma correction
     auto srgb_to_linear = [](double c) -> double {
       if (c <= 0.04045) return c / 12.92;
@@ -829,7 +1454,10 @@ struct Color {
 
     // Return black for light backgrounds, white for dark backgrounds
     // Threshold of 0.4 provides better contrast for mid-tone colors
-    return luminance > 0.4 ? Black() : White();
+    bool black = luminance > 0.4;
+    slot.store((key << 2) | (black ? 2u : 0u) | 1u,
+               std::memory_order_relaxed);
+    return black ? Black() : White();
   }
 
   /// @brief Convert HSV to RGB color
@@ -986,8 +1614,22 @@ struct Theme {
     return instance;
   }
 
-  /// @brief Set the global theme
-  static void set_theme(const Theme &t) { current() = t; }
+  /// @brief Set the global theme. Bumps the theme generation so widget
+  /// style caches re-resolve on their next render.
+  static void set_theme(const Theme &t) {
+    current() = t;
+    ++generation_ref();
+  }
+
+  /// @brief Monotonic counter identifying the current theme. Starts at 1
+  /// and moves only on set_theme, so a cache initialized to generation 0
+  /// is stale by construction. Code that mutates Theme::current() fields
+  /// in place must call set_theme (or bump_generation) for style caches
+  /// to notice.
+  static uint64_t generation() { return generation_ref(); }
+
+  /// @brief Invalidate all style caches without replacing the theme
+  static void bump_generation() { ++generation_ref(); }
 
   /// @brief Default Dark Theme (Catppuccin Mocha)
   /// Soothing pastel dark theme - https://catppuccin.com
@@ -1173,11 +1815,57 @@ struct Theme {
     t.menubar_fg = t.foreground;
     return t;
   }
+
+ private:
+  static uint64_t &generation_ref() {
+    static uint64_t generation = 1;
+    return generation;
+  }
+};
+
+/// @brief Per-widget cache of fully theme-resolved colors.
+///
+/// Widgets re-derive their effective colors from their override fields
+/// and the global theme on every render, even though themes change
+/// rarely. A StyleCache keeps the derived Style struct and re-runs the
+/// resolver only when the theme generation moved or an input changed.
+/// The override fields are public and assigned directly, so the key
+/// compares the input colors themselves (plus any widget state bits the
+/// style depends on) rather than counting mutations.
+template <typename Style>
+class StyleCache {
+ public:
+  /// @brief Return the cached style, re-resolving if stale
+  /// @param colors The widget's override color inputs
+  /// @param state Packed widget state bits the style depends on
+  /// @param resolver Callable producing a freshly resolved Style
+  template <typename Resolver>
+  const Style &get(std::initializer_list<Color> colors, uint32_t state,
+                   Resolver &&resolver) {
+    uint64_t generation = Theme::generation();
+    bool fresh = generation_ == generation && state_ == state &&
+                 colors_.size() == colors.size() &&
+                 std::equal(colors_.begin(), colors_.end(), colors.begin());
+    if (!fresh) {
+      style_ = resolver();
+      colors_.assign(colors.begin(), colors.end());
+      state_ = state;
+      generation_ = generation;
+    }
+    return style_;
+  }
+
+ private:
+  Style style_{};
+  std::vector<Color> colors_;
+  uint32_t state_ = 0;
+  uint64_t generation_ = 0;  ///< 0 never matches: generations start at 1
 };
 
 /// @brief A single terminal cell containing a character and styling attributes
+
 struct Cell {
-  std::string content = " ";  // UTF-8 supported by using string
+  CellGlyph content;  // UTF-8 glyph in compact inline storage
   Color fg_color;
   Color bg_color;
   bool bold = false;       ///< Render text in bold
@@ -1193,14 +1881,49 @@ struct Cell {
 };
 
 /// @brief A 2D grid of cells representing the terminal screen with clipping
-/// support
+/// support.
+///
+/// Internally the grid is stored as parallel arrays (glyphs, packed
+/// foreground/background colors, attribute bitfields) rather than an array
+/// of Cell structs, and every row carries a 64-bit digest that is updated
+/// incrementally on each write. Terminal::render compares row digests to
+/// skip entire unchanged rows with a single integer compare, and the flat
+/// per-field arrays keep the changed-row scan tight and cache-friendly.
+/// The public set/get/set_char API is unchanged apart from get() returning
+/// the Cell by value.
 class Buffer {
  public:
+  // Attribute bitfield values
+  static constexpr uint8_t kBold = 0x01;
+  static constexpr uint8_t kItalic = 0x02;
+  static constexpr uint8_t kUnderline = 0x04;
+
+  /// @brief Pack a Color into 32 bits. Default colors canonicalize to a
+  /// single value so logically-equal colors always pack identically.
+  static uint32_t pack_color(const Color &c) {
+    if (c.is_default) return kDefaultColor;
+    return (static_cast<uint32_t>(c.r) << 16) |
+           (static_cast<uint32_t>(c.g) << 8) | static_cast<uint32_t>(c.b);
+  }
+
+  /// @brief Unpack a 32-bit packed color back into a Color
+  static Color unpack_color(uint32_t packed) {
+    if (packed == kDefaultColor) return Color();
+    return Color(static_cast<uint8_t>(packed >> 16),
+                 static_cast<uint8_t>(packed >> 8),
+                 static_cast<uint8_t>(packed));
+  }
+
   /// @brief Construct a new Buffer with given dimensions
   /// @param width Width of the buffer
   /// @param height Height of the buffer
   Buffer(int width, int height) : width_(width), height_(height) {
-    cells_.resize(height * width);
+    size_t n = static_cast<size_t>(width) * height;
+    glyphs_.resize(n);
+    fg_.resize(n, kDefaultColor);
+    bg_.resize(n, kDefaultColor);
+    attrs_.resize(n, 0);
+    row_digests_.assign(height, empty_row_digest(width));
     // Default clip is full buffer
     clip_stack_.push_back({0, 0, width, height});
   }
@@ -1211,7 +1934,12 @@ class Buffer {
   void resize(int width, int height) {
     width_ = width;
     height_ = height;
-    cells_.assign(width * height, Cell{});
+    size_t n = static_cast<size_t>(width) * height;
+    glyphs_.assign(n, CellGlyph{});
+    fg_.assign(n, kDefaultColor);
+    bg_.assign(n, kDefaultColor);
+    attrs_.assign(n, 0);
+    row_digests_.assign(height, empty_row_digest(width));
     clip_stack_.clear();
     clip_stack_.push_back({0, 0, width, height});
   }
@@ -1256,7 +1984,18 @@ class Buffer {
     Rect c = current_clip();
     if (x >= c.x && x < c.x + c.width && y >= c.y && y < c.y + c.height) {
       if (x >= 0 && x < width_ && y >= 0 && y < height_) {
-        cells_[y * width_ + x] = cell;
+        size_t i = static_cast<size_t>(y) * width_ + x;
+        uint8_t attrs = pack_attrs(cell.bold, cell.italic, cell.underline);
+        uint32_t fg = pack_color(cell.fg_color);
+        uint32_t bg = pack_color(cell.bg_color);
+
+        uint64_t &digest = row_digests_[y];
+        digest ^= hash_cell(x, glyphs_[i], fg_[i], bg_[i], attrs_[i]);
+        glyphs_[i] = cell.content;
+        fg_[i] = fg;
+        bg_[i] = bg;
+        attrs_[i] = attrs;
+        digest ^= hash_cell(x, glyphs_[i], fg, bg, attrs);
       }
     }
   }
@@ -1269,7 +2008,11 @@ class Buffer {
     Rect c = current_clip();
     if (x >= c.x && x < c.x + c.width && y >= c.y && y < c.y + c.height) {
       if (x >= 0 && x < width_ && y >= 0 && y < height_) {
-        cells_[y * width_ + x].content = ch;
+        size_t i = static_cast<size_t>(y) * width_ + x;
+        uint64_t &digest = row_digests_[y];
+        digest ^= hash_cell(x, glyphs_[i], fg_[i], bg_[i], attrs_[i]);
+        glyphs_[i] = ch;
+        digest ^= hash_cell(x, glyphs_[i], fg_[i], bg_[i], attrs_[i]);
       }
     }
   }
@@ -1277,14 +2020,19 @@ class Buffer {
   /// @brief Get the cell at a specific location
   /// @param x X coordinate
   /// @param y Y coordinate
-  /// @return Const reference to the cell (or static empty cell if out of
-  /// bounds)
-  const Cell &get(int x, int y) const {
-    static Cell empty;
+  /// @return The cell value (or an empty cell if out of bounds)
+  Cell get(int x, int y) const {
+    Cell cell;
     if (x >= 0 && x < width_ && y >= 0 && y < height_) {
-      return cells_[y * width_ + x];
+      size_t i = static_cast<size_t>(y) * width_ + x;
+      cell.content = glyphs_[i];
+      cell.fg_color = unpack_color(fg_[i]);
+      cell.bg_color = unpack_color(bg_[i]);
+      cell.bold = (attrs_[i] & kBold) != 0;
+      cell.italic = (attrs_[i] & kItalic) != 0;
+      cell.underline = (attrs_[i] & kUnderline) != 0;
     }
-    return empty;
+    return cell;
   }
 
   /// @brief Get the width of the buffer
@@ -1292,16 +2040,181 @@ class Buffer {
   /// @brief Get the height of the buffer
   int height() const { return height_; }
 
+  /// @brief Get the 64-bit digest of a row. Two rows with equal digests
+  /// hold equal content (modulo hash collisions), so the diff loop can
+  /// skip unchanged rows with one integer compare.
+  /// @param y Row index (must be in range)
+  uint64_t row_digest(int y) const { return row_digests_[y]; }
+
+  /// @brief Direct read access to the glyph array for the diff/emit loop
+  const CellGlyph &glyph_at(size_t i) const { return glyphs_[i]; }
+  /// @brief Direct read access to packed foreground colors
+  uint32_t fg_at(size_t i) const { return fg_[i]; }
+  /// @brief Direct read access to packed background colors
+  uint32_t bg_at(size_t i) const { return bg_[i]; }
+  /// @brief Direct read access to attribute bitfields
+  uint8_t attrs_at(size_t i) const { return attrs_[i]; }
+
   /// @brief Clear the entire buffer with a specific cell
   /// @param fill_cell The cell to fill with (default is empty/default style)
   void clear(const Cell &fill_cell = Cell{}) {
-    std::fill(cells_.begin(), cells_.end(), fill_cell);
+    std::fill(glyphs_.begin(), glyphs_.end(), fill_cell.content);
+    std::fill(fg_.begin(), fg_.end(), pack_color(fill_cell.fg_color));
+    std::fill(bg_.begin(), bg_.end(), pack_color(fill_cell.bg_color));
+    std::fill(attrs_.begin(), attrs_.end(),
+              pack_attrs(fill_cell.bold, fill_cell.italic, fill_cell.underline));
+    std::fill(row_digests_.begin(), row_digests_.end(),
+              uniform_row_digest(fill_cell, 0, width_));
+  }
+
+  /// @brief Copy one row's cells and digest from another buffer with the
+  /// same width. Used by App::run to re-seed a swapped back buffer with
+  /// the rows the previous frame changed, so steady-state frames avoid a
+  /// full buffer copy.
+  /// @param src The buffer to copy from
+  /// @param y The row to copy
+  void copy_row_from(const Buffer &src, int y) {
+    if (y < 0 || y >= height_ || y >= src.height_ || width_ != src.width_)
+      return;
+    size_t base = static_cast<size_t>(y) * width_;
+    std::copy(src.glyphs_.begin() + base, src.glyphs_.begin() + base + width_,
+              glyphs_.begin() + base);
+    std::copy(src.fg_.begin() + base, src.fg_.begin() + base + width_,
+              fg_.begin() + base);
+    std::copy(src.bg_.begin() + base, src.bg_.begin() + base + width_,
+              bg_.begin() + base);
+    std::copy(src.attrs_.begin() + base, src.attrs_.begin() + base + width_,
+              attrs_.begin() + base);
+    row_digests_[y] = src.row_digests_[y];
+  }
+
+  /// @brief Swap contents with another buffer in O(1). Clip stacks travel
+  /// with the cell data.
+  void swap(Buffer &other) {
+    std::swap(width_, other.width_);
+    std::swap(height_, other.height_);
+    glyphs_.swap(other.glyphs_);
+    fg_.swap(other.fg_);
+    bg_.swap(other.bg_);
+    attrs_.swap(other.attrs_);
+    row_digests_.swap(other.row_digests_);
+    clip_stack_.swap(other.clip_stack_);
+  }
+
+  /// @brief Copy a rectangular region from another buffer of the same
+  /// dimensions, keeping row digests consistent. Used by the parallel
+  /// render path to seed a child's scratch buffer and to composite its
+  /// output back into the frame buffer.
+  /// @param src The buffer to copy from
+  /// @param r The region to copy
+  void copy_rect(const Buffer &src, const Rect &r) {
+    if (width_ != src.width_ || height_ != src.height_) return;
+    Rect c = r.intersect({0, 0, width_, height_});
+    if (c.width <= 0 || c.height <= 0) return;
+    for (int cy = c.y; cy < c.y + c.height; ++cy) {
+      if (c.x == 0 && c.width == width_) {
+        copy_row_from(src, cy);
+        continue;
+      }
+      size_t base = static_cast<size_t>(cy) * width_ + c.x;
+      uint64_t &digest = row_digests_[cy];
+      for (int cx = c.x; cx < c.x + c.width; ++cx) {
+        size_t i = static_cast<size_t>(cy) * width_ + cx;
+        digest ^= hash_cell(cx, glyphs_[i], fg_[i], bg_[i], attrs_[i]) ^
+                  hash_cell(cx, src.glyphs_[i], src.fg_[i], src.bg_[i],
+                            src.attrs_[i]);
+      }
+      std::copy(src.glyphs_.begin() + base, src.glyphs_.begin() + base + c.width,
+                glyphs_.begin() + base);
+      std::copy(src.fg_.begin() + base, src.fg_.begin() + base + c.width,
+                fg_.begin() + base);
+      std::copy(src.bg_.begin() + base, src.bg_.begin() + base + c.width,
+                bg_.begin() + base);
+      std::copy(src.attrs_.begin() + base, src.attrs_.begin() + base + c.width,
+                attrs_.begin() + base);
+    }
+  }
+
+  /// @brief Fill a rectangular region with a specific cell, clamped to the
+  /// buffer bounds. Used by the partial-redraw path to reset damaged areas
+  /// without touching the rest of the frame.
+  /// @param r The region to fill
+  /// @param fill_cell The cell to fill with
+  void fill_rect(const Rect &r, const Cell &fill_cell = Cell{}) {
+    Rect c = r.intersect({0, 0, width_, height_});
+    uint32_t fg = pack_color(fill_cell.fg_color);
+    uint32_t bg = pack_color(fill_cell.bg_color);
+    uint8_t attrs =
+        pack_attrs(fill_cell.bold, fill_cell.italic, fill_cell.underline);
+    for (int fy = c.y; fy < c.y + c.height; ++fy) {
+      uint64_t &digest = row_digests_[fy];
+      for (int fx = c.x; fx < c.x + c.width; ++fx) {
+        size_t i = static_cast<size_t>(fy) * width_ + fx;
+        digest ^= hash_cell(fx, glyphs_[i], fg_[i], bg_[i], attrs_[i]);
+        glyphs_[i] = fill_cell.content;
+        fg_[i] = fg;
+        bg_[i] = bg;
+        attrs_[i] = attrs;
+        digest ^= hash_cell(fx, glyphs_[i], fg, bg, attrs);
+      }
+    }
   }
 
  private:
+  static constexpr uint32_t kDefaultColor = 0x01000000;
+
+  static uint8_t pack_attrs(bool bold, bool italic, bool underline) {
+    return (bold ? kBold : 0) | (italic ? kItalic : 0) |
+           (underline ? kUnderline : 0);
+  }
+
+  /// @brief Position-aware hash of one cell's full state. Row digests are
+  /// the XOR of these over the row, so a write updates the digest by
+  /// XOR-ing the old hash out and the new hash in.
+  static uint64_t hash_cell(int x, const CellGlyph &glyph, uint32_t fg,
+                            uint32_t bg, uint8_t attrs) {
+    static_assert(sizeof(CellGlyph) == 8,
+                  "CellGlyph must stay 8 bytes for digest hashing");
+    uint64_t glyph_bits;
+    std::memcpy(&glyph_bits, &glyph, sizeof(glyph_bits));
+
+    // splitmix64-style finalizer over the combined state and position
+    uint64_t h = glyph_bits ^ (static_cast<uint64_t>(fg) |
+                               (static_cast<uint64_t>(bg) << 32));
+    h ^= static_cast<uint64_t>(attrs) << 24;
+    h += 0x9E3779B97F4A7C15ull * static_cast<uint64_t>(x + 1);
+    h ^= h >> 30;
+    h *= 0xBF58476D1CE4E5B9ull;
+    h ^= h >> 27;
+    h *= 0x94D049BB133111EBull;
+    h ^= h >> 31;
+    return h;
+  }
+
+  /// @brief Digest of a row uniformly filled with one cell value
+  static uint64_t uniform_row_digest(const Cell &cell, int from_x, int to_x) {
+    uint64_t digest = 0;
+    uint32_t fg = pack_color(cell.fg_color);
+    uint32_t bg = pack_color(cell.bg_color);
+    uint8_t attrs = pack_attrs(cell.bold, cell.italic, cell.underline);
+    for (int x = from_x; x < to_x; ++x) {
+      digest ^= hash_cell(x, cell.content, fg, bg, attrs);
+    }
+    return digest;
+  }
+
+  /// @brief Digest of a default-initialized row of the given width
+  static uint64_t empty_row_digest(int width) {
+    return uniform_row_digest(Cell{}, 0, width);
+  }
+
   int width_ = 0;
   int height_ = 0;
-  std::vector<Cell> cells_;
+  std::vector<CellGlyph> glyphs_;    ///< Glyph per cell (SoA)
+  std::vector<uint32_t> fg_;         ///< Packed foreground per cell (SoA)
+  std::vector<uint32_t> bg_;         ///< Packed background per cell (SoA)
+  std::vector<uint8_t> attrs_;       ///< Attribute bitfield per cell (SoA)
+  std::vector<uint64_t> row_digests_;  ///< Incremental digest per row
   std::vector<Rect> clip_stack_;
 };
 
@@ -1316,11 +2229,11 @@ inline int render_utf8_text(Buffer &buffer, const std::string &text,
     // Check width limit
     if (max_width > 0 && cell_x >= max_width) break;
 
-    uint32_t codepoint;
-    int byte_len;
-    if (utf8_decode_codepoint(text, pos, codepoint, byte_len)) {
+    size_t byte_len;
+    int dw;
+    if (TextHelper::utf8_decode_cluster(text, pos, byte_len, dw)) {
       Cell c;
-      c.content = text.substr(pos, byte_len);
+      c.content = std::string_view(text).substr(pos, byte_len);
       c.fg_color = fg;
       c.bg_color = bg;
       c.bold = bold;
@@ -1328,8 +2241,7 @@ inline int render_utf8_text(Buffer &buffer, const std::string &text,
       c.underline = underline;
       buffer.set(start_x + cell_x, start_y, c);
 
-      int dw = char_display_width(codepoint);
-      // Handle wide characters (CJK, emoji) by placing empty cell in next
+      // Handle wide clusters (CJK, emoji) by placing empty cell in next
       // position
       if (dw == 2 && (max_width == 0 || cell_x + 1 < max_width)) {
         Cell skip;
@@ -1618,6 +2530,92 @@ class VTParser {
     return event;
   }
 
+  /// @brief Process a whole input buffer, appending parsed events to @p out.
+  /// Fast paths over the per-byte state machine: in ground state a run of
+  /// printable bytes up to the next ESC/control byte becomes one Text event,
+  /// complete SGR mouse reports are decoded with a single tight scan (so a
+  /// motion flood is one cheap pass per report), and bracketed paste content
+  /// is appended to the paste buffer in bulk via memchr. Anything else —
+  /// including sequences split across chunk boundaries — falls back to
+  /// process(), which keeps its state between calls.
+  /// @param data The raw input bytes
+  /// @param len Number of bytes in @p data
+  /// @param out Parsed events are appended here
+  void process_chunk(const char *data, size_t len, std::vector<Event> &out) {
+    size_t i = 0;
+    while (i < len) {
+      // Bulk paste: everything up to the next ESC is literal content
+      if (state_ == State::BracketedPaste && paste_escape_state_ == 0 &&
+          data[i] != 27) {
+        const char *esc =
+            static_cast<const char *>(memchr(data + i, 27, len - i));
+        size_t run_end = esc ? (size_t)(esc - data) : len;
+        paste_buffer_.append(data + i, run_end - i);
+        i = run_end;
+        continue;
+      }
+
+      if (state_ == State::Start) {
+        unsigned char c = (unsigned char)data[i];
+
+        // Complete SGR mouse report (\033[<b;x;yM or m): decode in place
+        if (c == 27 && i + 2 < len && data[i + 1] == '[' &&
+            data[i + 2] == '<') {
+          size_t j = i + 3;
+          int params[3] = {0, 0, 0};
+          int np = 0;
+          while (j < len && np < 3) {
+            if (isdigit((unsigned char)data[j])) {
+              params[np] = params[np] * 10 + (data[j] - '0');
+              ++j;
+            } else if (data[j] == ';' && np < 2) {
+              ++np;
+              ++j;
+            } else {
+              break;
+            }
+          }
+          if (j < len && np == 2 && (data[j] == 'M' || data[j] == 'm')) {
+            Event ev;
+            ev.type = EventType::Mouse;
+            ev.x = params[1] - 1;
+            ev.y = params[2] - 1;
+            int b = params[0];
+            ev.shift = (b & 4) != 0;
+            ev.alt = (b & 8) != 0;
+            ev.ctrl = (b & 16) != 0;
+            ev.button = (data[j] == 'm') ? 3 : (b & ~(4 | 8 | 16));
+            out.push_back(ev);
+            i = j + 1;
+            continue;
+          }
+          // Incomplete or malformed: let the state machine handle it
+        } else if (c != 27 && c >= 32 && c != 127) {
+          // Plain-text run up to the next ESC or control byte. Runs of one
+          // byte stay ordinary Key events so shortcuts keep working.
+          size_t run_end = i + 1;
+          while (run_end < len) {
+            unsigned char rc = (unsigned char)data[run_end];
+            if (rc == 27 || rc < 32 || rc == 127) break;
+            ++run_end;
+          }
+          if (run_end - i > 1) {
+            Event ev;
+            ev.type = EventType::Text;
+            ev.paste_text.assign(data + i, run_end - i);
+            out.push_back(std::move(ev));
+            i = run_end;
+            continue;
+          }
+        }
+      }
+
+      Event ev = process(data[i]);
+      ++i;
+      if (ev.type != EventType::None) out.push_back(std::move(ev));
+    }
+  }
+
  private:
   enum class State {
     Start,
@@ -1774,6 +2772,16 @@ class VTParser {
   }
 };
 
+/// @brief Color fidelity of the SGR sequences Terminal::render emits.
+/// Truecolor uses 24-bit `38;2;r;g;b` parameters; the palette modes
+/// quantize to the xterm 256-color cube (`38;5;n`) or the classic 16
+/// basic colors, which cost far fewer bytes per color change.
+enum class ColorMode {
+  TrueColor,   ///< 24-bit RGB (38;2;r;g;b)
+  Palette256,  ///< xterm 256-color palette (38;5;n)
+  Basic16,     ///< Classic 30-37 / 90-97 SGR colors
+};
+
 /// @brief Low-level terminal I/O handling raw mode, rendering, and event
 /// polling
 class Terminal {
@@ -1804,10 +2812,121 @@ class Terminal {
   }
 
   /// @brief Construct the terminal interface and enable raw mode
-  Terminal() { enableRawMode(); }
+  Terminal() : Terminal(true) {}
 
   /// @brief Destructor restores the terminal to canonical mode
-  ~Terminal() { disableRawMode(); }
+  virtual ~Terminal() {
+    stop_writer();  // Outstanding frames land before the tty is restored
+    if (manages_tty_) disableRawMode();
+  }
+
+  /// @brief Capture hook: called with every event readEvent() returns (except
+  /// Wakeup). Record these to replay a session through
+  /// HeadlessTerminal::push_event later.
+  std::function<void(const Event &)> on_raw_event;
+
+  /// @brief Select the color fidelity of emitted SGR sequences. Cached
+  /// sequences embed the old encoding, so changing mode flushes them.
+  /// @param mode The output mode to use from the next frame on
+  void set_color_mode(ColorMode mode) {
+    if (color_mode_ == mode) return;
+    color_mode_ = mode;
+    sgr_cache_.clear();
+  }
+
+  /// @brief The color mode sequences are currently emitted in
+  ColorMode color_mode() const { return color_mode_; }
+
+  /// @brief Guess the best color mode from the environment, the same way
+  /// terminfo-aware tools do: COLORTERM advertising truecolor wins, a TERM
+  /// containing "256color" selects the palette, anything else (including a
+  /// missing TERM, e.g. headless runs) keeps truecolor rather than degrade
+  /// a capable terminal on a hunch.
+  static ColorMode detect_color_mode() {
+#ifdef _WIN32
+    return ColorMode::TrueColor;  // VT-enabled consoles accept 24-bit SGR
+#else
+    const char *colorterm = std::getenv("COLORTERM");
+    if (colorterm) {
+      std::string ct(colorterm);
+      if (ct.find("truecolor") != std::string::npos ||
+          ct.find("24bit") != std::string::npos) {
+        return ColorMode::TrueColor;
+      }
+    }
+    const char *term = std::getenv("TERM");
+    if (term) {
+      std::string t(term);
+      if (t.find("256color") != std::string::npos) return ColorMode::Palette256;
+      if (t.find("direct") != std::string::npos) return ColorMode::TrueColor;
+      return ColorMode::Basic16;
+    }
+    return ColorMode::TrueColor;
+#endif
+  }
+
+  /// @brief Wrap each frame in DEC 2026 synchronized-update guards so the
+  /// emulator applies it atomically instead of mid-scan (no tearing on
+  /// busy frames). Terminals without mode 2026 ignore the guards as
+  /// unknown private modes.
+  /// @param enabled Whether to emit the guards around every frame
+  void set_synchronized_output(bool enabled) { sync_output_ = enabled; }
+
+  /// @brief Whether frames are wrapped in synchronized-update guards
+  bool synchronized_output() const { return sync_output_; }
+
+  /// @brief Guess whether emitting synchronized-update guards makes sense.
+  /// Unknown private modes are ignored by anything modern, so only plainly
+  /// hardware-era TERM values opt out.
+  static bool detect_synchronized_output() {
+#ifdef _WIN32
+    return true;
+#else
+    const char *term = std::getenv("TERM");
+    if (!term || !*term) return false;
+    std::string t(term);
+    return t != "dumb" && t.rfind("vt", 0) != 0;
+#endif
+  }
+
+  /// @brief Route presented frames through a background writer thread so a
+  /// congested link never stalls the event loop: render() hands the frame
+  /// bytes over and returns immediately, and App::run consults
+  /// output_pending() to skip producing new frames while one is in flight.
+  /// Skipped updates coalesce into the next rendered frame. Handed-over
+  /// frames are never dropped — the diff stream is stateful, so every
+  /// frame's bytes must reach the terminal in order. Subclasses that
+  /// override write() must disable this in their own destructor before
+  /// their override is torn down (HeadlessTerminal does).
+  /// @param enabled Whether to start (or drain and stop) the writer
+  void set_async_output(bool enabled) {
+    if (enabled == async_output_) return;
+    if (enabled) {
+      writer_stop_ = false;
+      writer_thread_ = std::thread([this] { writer_loop(); });
+    } else {
+      stop_writer();
+    }
+    async_output_ = enabled;
+  }
+
+  /// @brief Whether the background writer thread is active
+  bool async_output() const { return async_output_; }
+
+  /// @brief True while a presented frame is queued or being written
+  bool output_pending() const {
+    if (!async_output_) return false;
+    std::lock_guard<std::mutex> lock(present_mutex_);
+    return writer_busy_ || !pending_frames_.empty();
+  }
+
+  /// @brief Block until every presented frame has been written and flushed
+  void wait_output_drained() {
+    if (!async_output_) return;
+    std::unique_lock<std::mutex> lock(present_mutex_);
+    present_cv_.wait(lock,
+                     [&] { return !writer_busy_ && pending_frames_.empty(); });
+  }
 
   /// @brief Enable raw mode, allowing direct input processing and disabling
   /// echo
@@ -1963,10 +3082,14 @@ class Terminal {
 
   /// @brief Write raw string data to the terminal output
   /// @param data The string to write
-  void write(const std::string &data) { std::cout << data; }
+  virtual void write(const std::string &data) { std::cout << data; }
 
   /// @brief Flush the output stream
-  void flush() { std::cout.flush(); }
+  virtual void flush() { std::cout.flush(); }
+
+  /// @brief Get the screen size this backend renders to
+  /// @return A pair containing {width, height}
+  virtual std::pair<int, int> size() const { return getSize(); }
 
   /// @brief Move the cursor to a specific position
   /// @param x X coordinate (0-based)
@@ -1987,7 +3110,7 @@ class Terminal {
   /// @brief Drain any stale events from the input buffer
   /// Call this after initialization to clear spurious events (e.g., resize from
   /// alternate buffer switch)
-  void drainInputBuffer() {
+  virtual void drainInputBuffer() {
 #ifdef _WIN32
     HANDLE hIn = GetStdHandle(STD_INPUT_HANDLE);
     DWORD nEvents = 0;
@@ -2030,121 +3153,334 @@ class Terminal {
   /// @brief Render buffer differences using batched output for optimal
   /// performance
   void render(const Buffer &current, const Buffer &previous) {
-    std::string output;
+    render(current, previous, {});
+  }
+
+  /// @brief Render buffer differences, optionally confined to damaged
+  /// rectangles. When @p damage is non-empty only cells inside those rects
+  /// are compared and emitted; App::run merges overlapping rects before
+  /// calling. An empty list scans the full buffer.
+  /// @param current The buffer to present
+  /// @param previous The buffer currently on screen
+  /// @param damage The damaged regions to scan (empty = full scan)
+  void render(const Buffer &current, const Buffer &previous,
+              const std::vector<Rect> &damage) {
+    // Frame bytes accumulate into a buffer reused across frames, so a
+    // steady-state frame appends into already-reserved capacity instead of
+    // growing a fresh string
+    std::string &output = frame_output_;
+    output.clear();
     output.reserve(current.width() * current.height() * 30);
 
-    // Track render state to emit only changed attributes
-    Color cur_fg;
-    Color cur_bg;
-    bool cur_bold = false;
-    bool cur_italic = false;
-    bool cur_underline = false;
+    if (sync_output_) output += "\033[?2026h";  // Begin synchronized update
+
+    // Track render state (packed colors + attribute bits) to emit only
+    // changed attributes
+    const uint32_t default_color = Buffer::pack_color(Color());
+    uint32_t cur_fg = default_color;
+    uint32_t cur_bg = default_color;
+    uint8_t cur_attrs = 0;
     int cur_x = -1;
     int cur_y = -1;
 
     // Append cursor move (CSI row;col H)
     auto appendCursorMove = [&output](int x, int y) {
       output += "\033[";
-      output += std::to_string(y + 1);
+      append_int(output, y + 1);
       output += ";";
-      output += std::to_string(x + 1);
+      append_int(output, x + 1);
       output += "H";
     };
 
-    // Append foreground color (SGR 38;2;r;g;b)
-    auto appendFgColor = [&output](const Color &c) {
-      if (!c.is_default) {
-        output += "\033[38;2;";
-        output += std::to_string(c.r);
-        output += ";";
-        output += std::to_string(c.g);
-        output += ";";
-        output += std::to_string(c.b);
-        output += "m";
-      } else {
-        output += "\033[39m";
-      }
-    };
+    // Row digests are only comparable when both buffers share dimensions
+    // (App::run resizes them together; mismatch falls back to get())
+    bool same_dims = current.width() == previous.width() &&
+                     current.height() == previous.height();
 
-    // Append background color (SGR 48;2;r;g;b)
-    auto appendBgColor = [&output](const Color &c) {
-      if (!c.is_default) {
-        output += "\033[48;2;";
-        output += std::to_string(c.r);
-        output += ";";
-        output += std::to_string(c.g);
-        output += ";";
-        output += std::to_string(c.b);
-        output += "m";
-      } else {
-        output += "\033[49m";
-      }
-    };
+    // Scan either the full buffer or just the damaged rectangles
+    Rect full{0, 0, current.width(), current.height()};
+    const Rect *rects = damage.empty() ? &full : damage.data();
+    size_t rect_count = damage.empty() ? 1 : damage.size();
 
-    for (int y = 0; y < current.height(); ++y) {
-      for (int x = 0; x < current.width(); ++x) {
-        const Cell &currCell = current.get(x, y);
-        const Cell &prevCell = previous.get(x, y);
+    int cells_diffed = 0;  // Profiler: cells emitted this frame
 
-        if (currCell != prevCell) {
-          // Position cursor (skip if already there from previous write)
-          if (cur_x != x || cur_y != y) {
-            appendCursorMove(x, y);
-          }
+    for (size_t ri = 0; ri < rect_count; ++ri) {
+      Rect r = rects[ri].intersect(full);
+      for (int y = r.y; y < r.y + r.height; ++y) {
+        // One integer compare skips an entire unchanged row
+        if (same_dims && current.row_digest(y) == previous.row_digest(y)) {
+          continue;
+        }
 
-          // Foreground
-          if (currCell.fg_color != cur_fg) {
-            appendFgColor(currCell.fg_color);
-            cur_fg = currCell.fg_color;
+        size_t row_base = static_cast<size_t>(y) * current.width();
+        for (int x = r.x; x < r.x + r.width; ++x) {
+          size_t i = row_base + x;
+          const CellGlyph &glyph = current.glyph_at(i);
+          uint32_t fg = current.fg_at(i);
+          uint32_t bg = current.bg_at(i);
+          uint8_t attrs = current.attrs_at(i);
+
+          bool changed;
+          if (same_dims) {
+            // Tight per-field compares over the parallel arrays
+            changed = glyph != previous.glyph_at(i) ||
+                      fg != previous.fg_at(i) || bg != previous.bg_at(i) ||
+                      attrs != previous.attrs_at(i);
+          } else {
+            changed = current.get(x, y) != previous.get(x, y);
           }
 
-          // Background
-          if (currCell.bg_color != cur_bg) {
-            appendBgColor(currCell.bg_color);
-            cur_bg = currCell.bg_color;
-          }
+          if (changed) {
+            ++cells_diffed;
 
-          // Style attributes
-          if (currCell.bold != cur_bold) {
-            output += currCell.bold ? "\033[1m" : "\033[22m";
-            cur_bold = currCell.bold;
-          }
-          if (currCell.italic != cur_italic) {
-            output += currCell.italic ? "\033[3m" : "\033[23m";
-            cur_italic = currCell.italic;
-          }
-          if (currCell.underline != cur_underline) {
-            output += currCell.underline ? "\033[4m" : "\033[24m";
-            cur_underline = currCell.underline;
-          }
+            // Position cursor (skip if already there from previous write)
+            if (cur_x != x || cur_y != y) {
+              appendCursorMove(x, y);
+            }
 
-          // Content
-          output += currCell.content;
+            // Styling: one cached, ready-made SGR sequence per state change
+            if (fg != cur_fg || bg != cur_bg || attrs != cur_attrs) {
+              output += sgr_sequence(fg, bg, attrs);
+              cur_fg = fg;
+              cur_bg = bg;
+              cur_attrs = attrs;
+            }
 
-          // Calculate display width for proper cursor tracking
-          int display_width = utf8_display_width(currCell.content);
-          if (display_width < 1) display_width = 1;
+            // Content
+            output += glyph.view();
 
-          // Cursor advances by display width after write
-          cur_x = x + display_width;
-          cur_y = y;
+            // Display width is cached in the glyph for cursor tracking
+            int display_width = glyph.display_width();
+            if (display_width < 1) display_width = 1;
 
-          // Skip cells occupied by wide character
-          if (display_width > 1) {
-            x += display_width - 1;
+            // Cursor advances by display width after write
+            cur_x = x + display_width;
+            cur_y = y;
+
+            // Skip cells occupied by wide character
+            if (display_width > 1) {
+              x += display_width - 1;
+            }
           }
         }
       }
     }
 
     output += "\033[0m";  // Reset attributes
+    if (sync_output_) output += "\033[?2026l";  // End synchronized update
 
-    // Single write and flush for entire frame
-    write(output);
-    flush();
+    g_frame_profiler.note_diff(cells_diffed, output.size());
+
+    // Single handoff for the entire frame
+    if (async_output_) {
+      present_async(frame_output_);
+    } else {
+      write(output);
+      flush();
+    }
   }
 
  private:
+  /// @brief Append a non-negative integer as ASCII without std::to_string
+  static void append_int(std::string &out, int v) {
+    char buf[12];
+    int n = 0;
+    do {
+      buf[n++] = static_cast<char>('0' + v % 10);
+      v /= 10;
+    } while (v > 0);
+    while (n > 0) out += buf[--n];
+  }
+
+  /// @brief Look up (or build) the full SGR escape sequence for a packed
+  /// render state. The diff emitter appends the cached bytes whenever the
+  /// style changes, so a styled run costs a single string append instead
+  /// of five std::to_string calls and a dozen small concatenations.
+  const std::string &sgr_sequence(uint32_t fg, uint32_t bg, uint8_t attrs) {
+    // Packed colors fit in 25 bits (the default sentinel is bit 24)
+    uint64_t key = static_cast<uint64_t>(fg) |
+                   (static_cast<uint64_t>(bg) << 25) |
+                   (static_cast<uint64_t>(attrs) << 50);
+
+    auto it = sgr_cache_.find(key);
+    if (it != sgr_cache_.end()) return it->second;
+
+    // Bound the cache; theme-heavy dashboards use a few dozen states, so
+    // hitting the cap means pathological input - just start over
+    if (sgr_cache_.size() >= 4096) sgr_cache_.clear();
+
+    const uint32_t default_color = Buffer::pack_color(Color());
+    std::string seq = "\033[";
+    seq += (attrs & Buffer::kBold) ? "1;" : "22;";
+    seq += (attrs & Buffer::kItalic) ? "3;" : "23;";
+    seq += (attrs & Buffer::kUnderline) ? "4;" : "24;";
+    if (fg != default_color) {
+      append_sgr_color(seq, fg, false);
+      seq += ";";
+    } else {
+      seq += "39;";
+    }
+    if (bg != default_color) {
+      append_sgr_color(seq, bg, true);
+      seq += "m";
+    } else {
+      seq += "49m";
+    }
+
+    return sgr_cache_.emplace(key, std::move(seq)).first->second;
+  }
+
+  /// @brief Append the SGR color parameters for a packed color (no leading
+  /// or trailing separator), encoded per the active color mode. The result
+  /// lands in sgr_cache_, so quantization runs once per distinct color.
+  void append_sgr_color(std::string &seq, uint32_t packed,
+                        bool background) const {
+    switch (color_mode_) {
+      case ColorMode::TrueColor:
+        seq += background ? "48;2;" : "38;2;";
+        append_int(seq, (packed >> 16) & 0xFF);
+        seq += ";";
+        append_int(seq, (packed >> 8) & 0xFF);
+        seq += ";";
+        append_int(seq, packed & 0xFF);
+        break;
+      case ColorMode::Palette256:
+        seq += background ? "48;5;" : "38;5;";
+        append_int(seq, quantize_256(packed));
+        break;
+      case ColorMode::Basic16: {
+        int idx = quantize_16(packed);
+        append_int(seq, idx < 8 ? (background ? 40 : 30) + idx
+                                : (background ? 100 : 90) + (idx - 8));
+        break;
+      }
+    }
+  }
+
+  /// @brief Nearest xterm-256 palette index for a packed RGB color. The
+  /// 6x6x6 cube and the grayscale ramp are both regular, so the nearest
+  /// candidate in each is computed directly and the closer one wins.
+  static int quantize_256(uint32_t packed) {
+    int r = (packed >> 16) & 0xFF;
+    int g = (packed >> 8) & 0xFF;
+    int b = packed & 0xFF;
+
+    // Cube levels are 0, 95, 135, 175, 215, 255
+    auto cube_index = [](int v) {
+      if (v < 48) return 0;
+      if (v < 115) return 1;
+      return (v - 35) / 40;
+    };
+    static constexpr int kCubeLevel[6] = {0, 95, 135, 175, 215, 255};
+    int ci = cube_index(r), cj = cube_index(g), ck = cube_index(b);
+    int cr = kCubeLevel[ci], cg = kCubeLevel[cj], cb = kCubeLevel[ck];
+
+    // Grayscale ramp is 8 + 10 * i for i in [0, 23]
+    int avg = (r + g + b) / 3;
+    int gi = avg <= 8 ? 0 : avg >= 238 ? 23 : (avg - 3) / 10;
+    int gv = 8 + 10 * gi;
+
+    auto dist2 = [](int r1, int g1, int b1, int r2, int g2, int b2) {
+      int dr = r1 - r2, dg = g1 - g2, db = b1 - b2;
+      return dr * dr + dg * dg + db * db;
+    };
+    if (dist2(r, g, b, gv, gv, gv) < dist2(r, g, b, cr, cg, cb)) {
+      return 232 + gi;
+    }
+    return 16 + 36 * ci + 6 * cj + ck;
+  }
+
+  /// @brief Nearest basic-16 palette index (xterm's default RGB values)
+  static int quantize_16(uint32_t packed) {
+    static constexpr int kBasic[16][3] = {
+        {0, 0, 0},       {205, 0, 0},     {0, 205, 0},    {205, 205, 0},
+        {0, 0, 238},     {205, 0, 205},   {0, 205, 205},  {229, 229, 229},
+        {127, 127, 127}, {255, 0, 0},     {0, 255, 0},    {255, 255, 0},
+        {92, 92, 255},   {255, 0, 255},   {0, 255, 255},  {255, 255, 255}};
+    int r = (packed >> 16) & 0xFF;
+    int g = (packed >> 8) & 0xFF;
+    int b = packed & 0xFF;
+    int best = 0, best_d = 3 * 255 * 255 + 1;
+    for (int i = 0; i < 16; ++i) {
+      int dr = r - kBasic[i][0], dg = g - kBasic[i][1], db = b - kBasic[i][2];
+      int d = dr * dr + dg * dg + db * db;
+      if (d < best_d) {
+        best_d = d;
+        best = i;
+      }
+    }
+    return best;
+  }
+
+  /// @brief Precomputed SGR sequences keyed by packed (fg, bg, attrs) state
+  std::unordered_map<uint64_t, std::string> sgr_cache_;
+
+  /// @brief Per-frame output accumulator, reused so render() stops
+  /// reallocating once a steady-state frame size is reached
+  std::string frame_output_;
+
+  /// @brief Encoding used for color SGR parameters (see set_color_mode)
+  ColorMode color_mode_ = ColorMode::TrueColor;
+
+  /// @brief Hand a finished frame to the writer thread. The caller's
+  /// buffer is swapped for an already-written one so its capacity keeps
+  /// being reused across frames.
+  void present_async(std::string &frame) {
+    {
+      std::lock_guard<std::mutex> lock(present_mutex_);
+      pending_frames_.push_back(std::move(frame));
+      if (!spent_buffers_.empty()) {
+        frame = std::move(spent_buffers_.back());
+        spent_buffers_.pop_back();
+      } else {
+        frame = std::string();
+      }
+    }
+    present_cv_.notify_all();
+  }
+
+  /// @brief Writer thread body: drain the frame FIFO in order, blocking on
+  /// the link off the UI thread. Also drains outstanding frames on stop.
+  void writer_loop() {
+    std::unique_lock<std::mutex> lock(present_mutex_);
+    while (true) {
+      present_cv_.wait(
+          lock, [&] { return writer_stop_ || !pending_frames_.empty(); });
+      if (writer_stop_ && pending_frames_.empty()) return;
+      std::string frame = std::move(pending_frames_.front());
+      pending_frames_.pop_front();
+      writer_busy_ = true;
+      lock.unlock();
+      write(frame);  // Blocking is fine here; the UI thread never waits
+      flush();
+      lock.lock();
+      writer_busy_ = false;
+      frame.clear();  // Keep the capacity for buffer recycling
+      if (spent_buffers_.size() < 2) spent_buffers_.push_back(std::move(frame));
+      present_cv_.notify_all();  // Wake output_pending()/drain waiters
+    }
+  }
+
+  /// @brief Drain outstanding frames, then join the writer thread
+  void stop_writer() {
+    {
+      std::lock_guard<std::mutex> lock(present_mutex_);
+      writer_stop_ = true;
+    }
+    present_cv_.notify_all();
+    if (writer_thread_.joinable()) writer_thread_.join();
+  }
+
+  bool sync_output_ = false;   ///< Emit DEC 2026 guards around frames
+  bool async_output_ = false;  ///< Frames go through the writer thread
+  mutable std::mutex present_mutex_;
+  std::condition_variable present_cv_;
+  std::thread writer_thread_;
+  std::deque<std::string> pending_frames_;  ///< FIFO to the writer thread
+  std::vector<std::string> spent_buffers_;  ///< Written-out capacity to reuse
+  bool writer_busy_ = false;  ///< A frame is on the wire right now
+  bool writer_stop_ = false;  ///< Writer exits once the FIFO drains
+
   bool vt_input_supported_ = false;
 
  public:
@@ -2173,7 +3509,7 @@ class Terminal {
   /// @brief Read an event from input
   /// @param timeout_ms Maximum time to wait in milliseconds (-1 for infinite)
   /// @return The read Event (or EventType::None if timeout)
-  Event readRawEvent(int timeout_ms = -1) {
+  virtual Event readRawEvent(int timeout_ms = -1) {
     Event event;
     event.type = EventType::None;
 
@@ -2472,6 +3808,13 @@ class Terminal {
       return event;
     }
 
+    // Deliver events already parsed from a previous chunk before reading more
+    if (!pending_events_.empty()) {
+      event = std::move(pending_events_.front());
+      pending_events_.pop_front();
+      return event;
+    }
+
     {
       fd_set fds;
       FD_ZERO(&fds);
@@ -2520,10 +3863,13 @@ class Terminal {
       }
     }
 
-    // Loop to consume buffer until event found or empty
+    // Chunked reads: pull whole buffers and run them through the batch
+    // parser, so a paste or mouse flood costs one parse pass instead of a
+    // state-machine step per byte. Events beyond the first are queued in
+    // pending_events_ and drained by subsequent calls.
     while (true) {
-      char c;
-      int nread = read(STDIN_FILENO, &c, 1);
+      char buf[4096];
+      int nread = (int)read(STDIN_FILENO, buf, sizeof(buf));
       if (nread < 0 && errno == EINTR) {
         if (g_resize_pending) { /*...*/
         }
@@ -2531,8 +3877,15 @@ class Terminal {
       }
       if (nread <= 0) break;  // End of input (for this poll)
 
-      event = parser_.process(c);
-      if (event.type != EventType::None) return event;
+      chunk_events_.clear();
+      parser_.process_chunk(buf, (size_t)nread, chunk_events_);
+      for (auto &e : chunk_events_) pending_events_.push_back(std::move(e));
+
+      if (!pending_events_.empty()) {
+        event = std::move(pending_events_.front());
+        pending_events_.pop_front();
+        return event;
+      }
 
       // Partial read; continue, but give a small grace period for the rest of
       // an escape sequence Often terminals send escape sequences in bursts, but
@@ -2594,28 +3947,137 @@ class Terminal {
       // Reset click count on other major interactions
       current_click_count_ = 0;
     }
-
+
+    if (on_raw_event && event.type != EventType::None &&
+        event.type != EventType::Wakeup) {
+      on_raw_event(event);
+    }
+
+    return event;
+  }
+
+ protected:
+  /// @brief Backend constructor. When @p manage_tty is false the real tty is
+  /// left completely untouched (no raw mode, no alternate screen, no signal
+  /// handlers); subclasses supply their own I/O instead.
+  explicit Terminal(bool manage_tty) : manages_tty_(manage_tty) {
+    if (manages_tty_) {
+      enableRawMode();
+      // Real terminals get environment-based autodetection; offscreen
+      // backends stay truecolor with no frame guards so captured output
+      // is deterministic
+      color_mode_ = detect_color_mode();
+      sync_output_ = detect_synchronized_output();
+    }
+  }
+
+  bool manages_tty_ = true;
+
+ private:
+#ifdef _WIN32
+  DWORD originalOutMode;
+  DWORD originalInMode;
+  UINT originalOutCP;
+  UINT originalInCP;
+  bool vt_supported_ = false;
+#else
+  struct termios originalTermios;
+#endif
+  VTParser parser_;
+
+  // Chunked input: events parsed but not yet delivered, plus a reusable
+  // scratch vector for each parse pass
+  std::deque<Event> pending_events_;
+  std::vector<Event> chunk_events_;
+
+  // Multi-click tracking
+  std::chrono::steady_clock::time_point last_click_time_;
+  int last_click_button_ = -1;
+  int last_click_x_ = -1;
+  int last_click_y_ = -1;
+  int current_click_count_ = 0;
+};
+
+/// @brief Terminal backend that never touches the real tty. Events come from
+/// a synthetic queue (push_event / push_input) and are drained at full speed;
+/// everything the library writes is captured in output() instead of going to
+/// stdout. Pass one to App::run(root, term) to render frames in CI, replay a
+/// recorded session (see Terminal::on_raw_event), or benchmark without a pty.
+/// By default the app quits after one final frame once the queue is empty;
+/// with quit_when_drained disabled the loop spins, so only do that when
+/// another thread keeps feeding events.
+class HeadlessTerminal : public Terminal {
+ public:
+  bool quit_when_drained = true;  ///< Stop App::run when the queue empties
+
+  /// @brief Construct with a fixed reported screen size
+  explicit HeadlessTerminal(int width = 80, int height = 24)
+      : Terminal(false), width_(width), height_(height) {}
+
+  /// @brief Stop the async writer while the write() override still exists
+  ~HeadlessTerminal() override { set_async_output(false); }
+
+  /// @brief Queue a synthetic event for the event loop
+  void push_event(const Event &event) { events_.push_back(event); }
+
+  /// @brief Feed raw bytes (e.g. a recorded input stream) through the
+  /// chunked VT parser and queue the resulting events
+  void push_input(const std::string &bytes) {
+    std::vector<Event> events;
+    parser_.process_chunk(bytes.data(), bytes.size(), events);
+    for (auto &e : events) events_.push_back(std::move(e));
+  }
+
+  /// @brief Everything written since the last clear_output()
+  const std::string &output() const { return output_; }
+
+  /// @brief Discard the captured byte stream
+  void clear_output() { output_.clear(); }
+
+  /// @brief Change the reported size and queue the matching Resize event
+  void resize(int width, int height) {
+    width_ = width;
+    height_ = height;
+    Event e;
+    e.type = EventType::Resize;
+    e.x = width;
+    e.y = height;
+    events_.push_back(e);
+  }
+
+  std::pair<int, int> size() const override { return {width_, height_}; }
+  void write(const std::string &data) override { output_ += data; }
+  void flush() override {}
+  void drainInputBuffer() override {}
+
+  Event readRawEvent(int /*timeout_ms*/ = -1) override {
+    Event event;
+    event.type = EventType::None;
+    if (events_.empty()) {
+      if (quit_when_drained) {
+        // One Wakeup first so pending state gets a final frame, then quit
+        if (!drain_wakeup_sent_) {
+          drain_wakeup_sent_ = true;
+          event.type = EventType::Wakeup;
+        } else if (quit_app) {
+          quit_app();
+        }
+      }
+      return event;
+    }
+    drain_wakeup_sent_ = false;
+    event = events_.front();
+    events_.pop_front();
     return event;
   }
 
  private:
-#ifdef _WIN32
-  DWORD originalOutMode;
-  DWORD originalInMode;
-  UINT originalOutCP;
-  UINT originalInCP;
-  bool vt_supported_ = false;
-#else
-  struct termios originalTermios;
-#endif
+  int width_;
+  int height_;
+  std::deque<Event> events_;
+  std::string output_;
   VTParser parser_;
-
-  // Multi-click tracking
-  std::chrono::steady_clock::time_point last_click_time_;
-  int last_click_button_ = -1;
-  int last_click_x_ = -1;
-  int last_click_y_ = -1;
-  int current_click_count_ = 0;
+  bool drain_wakeup_sent_ = false;
 };
 
 /// @brief Screen width categories for responsive layouts
@@ -2804,6 +4266,29 @@ class Widget : public std::enable_shared_from_this<Widget> {
    */
   virtual bool hit_test(int px, int py) const { return contains(px, py); }
 
+  /// @brief Mark this widget's current bounds as needing a redraw.
+  /// The damaged region is accumulated by App::run, which re-renders only
+  /// widgets intersecting it on the next frame. Call after changing state
+  /// that affects appearance (e.g. pushing a new Sparkline sample).
+  void mark_dirty() {
+    if (visible && width > 0 && height > 0) {
+      g_damage_rects.push_back({x, y, width, height});
+    }
+  }
+
+  /// @brief Request a full-tree redraw on the next frame.
+  /// This is the fallback for resize, theme changes, and any update that
+  /// cannot be described by per-widget damage rectangles.
+  static void mark_all_dirty() { g_full_damage = true; }
+
+  /**
+   * @brief Whether this widget may render outside its own layout bounds.
+   * Overlay widgets (Tooltip, Notification) draw at screen-absolute
+   * coordinates via push_full_clip, so they must not be skipped by
+   * clip-based culling during partial redraws.
+   */
+  virtual bool renders_outside_bounds() const { return false; }
+
  protected:
   inline static Widget *focused_widget_ = nullptr;
   bool focused_ = false;
@@ -2995,7 +4480,8 @@ class Static : public Widget {
     int current_x = x;
     int current_y = y;
 
-    std::vector<CharInfo> chars = prepare_text_for_render(text_);
+    auto chars_ref = prepare_text_cached(text_);
+    const std::vector<CharInfo> &chars = *chars_ref;
     int char_idx = 0;
 
     for (const auto &ci : chars) {
@@ -3218,7 +4704,8 @@ class Label : public Widget {
   void render(Buffer &buffer) override {
     Color fg = fg_color.resolve(Theme::current().foreground);
 
-    std::vector<CharInfo> chars = prepare_text_for_render(text_);
+    auto chars_ref = prepare_text_cached(text_);
+    const std::vector<CharInfo> &chars = *chars_ref;
 
     for (int dy = 0; dy < height; ++dy) {
       for (int dx = 0; dx < width; ++dx) {
@@ -3331,17 +4818,7 @@ class Paragraph : public Widget {
   bool selectable = true;
 
   void render(Buffer &buffer) override {
-    const std::string &plain = text;
-
-    std::vector<std::string> lines;
-    if (word_wrap)
-      lines = wrap_text_static(plain, width, first_line_indent, hanging_indent,
-                               preserve_whitespace);
-    else {
-      std::istringstream stream(plain);
-      std::string line;
-      while (std::getline(stream, line)) lines.push_back(line);
-    }
+    const std::vector<std::string> &lines = wrapped_lines();
 
     bool has_styled = !styled_content.empty();
     struct SpanPos {
@@ -3369,7 +4846,8 @@ class Paragraph : public Widget {
          ++line_idx) {
       const std::string &line = lines[line_idx];
       int indent = (line_idx == 0) ? first_line_indent : hanging_indent;
-      auto chars = TextHelper::prepare_text_for_render(line);
+      auto chars_ref = TextHelper::prepare_text_cached(line);
+      const std::vector<CharInfo> &chars = *chars_ref;
 
       for (int dx = 0; dx < width; ++dx) {
         int sx = x + dx;
@@ -3442,7 +4920,7 @@ class Paragraph : public Widget {
         set_focus(true);
         int new_pos = visual_to_char_idx(event.x, event.y);
         selection_state_.handle_mouse_press(
-            TextHelper::prepare_text_for_render(text), new_pos,
+            *TextHelper::prepare_text_cached(text), new_pos,
             event.click_count);
         return true;
       }
@@ -3482,16 +4960,9 @@ class Paragraph : public Widget {
   }
 
   int visual_to_char_idx(int vx, int vy) const {
+    // Selection hit-testing reuses the same wrap layout the renderer drew
+    const std::vector<std::string> &lines = wrapped_lines();
     const std::string &plain = text;
-    std::vector<std::string> lines;
-    if (word_wrap)
-      lines = wrap_text_static(plain, width, first_line_indent, hanging_indent,
-                               preserve_whitespace);
-    else {
-      std::istringstream stream(plain);
-      std::string line;
-      while (std::getline(stream, line)) lines.push_back(line);
-    }
 
     int char_offset = 0;
     int rel_y = vy - y;
@@ -3499,7 +4970,8 @@ class Paragraph : public Widget {
 
     for (int i = 0; i < (int)lines.size(); ++i) {
       int indent = (i == 0) ? first_line_indent : hanging_indent;
-      auto chars = TextHelper::prepare_text_for_render(lines[i]);
+      auto chars_ref = TextHelper::prepare_text_cached(lines[i]);
+      const std::vector<CharInfo> &chars = *chars_ref;
       if (i == rel_y) {
         int rel_x = vx - x - indent;
         int cur_vx = 0;
@@ -3649,6 +5121,44 @@ class Paragraph : public Widget {
   }
 
  private:
+  /// @brief Wrapped-line layout reused across frames. Re-wrapping a long
+  /// paragraph every frame dwarfs the cost of validating the key, so the
+  /// key is the full wrap input (text plus geometry); assigning the public
+  /// fields directly still invalidates correctly. Selection hit-testing
+  /// shares the same layout instead of re-wrapping.
+  const std::vector<std::string> &wrapped_lines() const {
+    if (wrap_cache_width_ != width || wrap_cache_wrap_ != word_wrap ||
+        wrap_cache_first_ != first_line_indent ||
+        wrap_cache_hang_ != hanging_indent ||
+        wrap_cache_preserve_ != preserve_whitespace ||
+        wrap_cache_text_ != text) {
+      if (word_wrap) {
+        wrap_cache_ = wrap_text_static(text, width, first_line_indent,
+                                       hanging_indent, preserve_whitespace);
+      } else {
+        wrap_cache_.clear();
+        std::istringstream stream(text);
+        std::string line;
+        while (std::getline(stream, line)) wrap_cache_.push_back(line);
+      }
+      wrap_cache_text_ = text;
+      wrap_cache_width_ = width;
+      wrap_cache_first_ = first_line_indent;
+      wrap_cache_hang_ = hanging_indent;
+      wrap_cache_wrap_ = word_wrap;
+      wrap_cache_preserve_ = preserve_whitespace;
+    }
+    return wrap_cache_;
+  }
+
+  mutable std::vector<std::string> wrap_cache_;
+  mutable std::string wrap_cache_text_;
+  mutable int wrap_cache_width_ = -1;
+  mutable int wrap_cache_first_ = -1;
+  mutable int wrap_cache_hang_ = -1;
+  mutable bool wrap_cache_wrap_ = false;
+  mutable bool wrap_cache_preserve_ = false;
+
   SelectionState selection_state_;
 };
 
@@ -3756,11 +5266,7 @@ class TextList : public Widget {
       int base_indent = item.level * indent_per_level;
       int text_width = width - base_indent - marker_width;
 
-      std::vector<std::string> lines;
-      if (word_wrap && text_width > 0)
-        lines = wrap_text(item.text, text_width);
-      else
-        lines = {item.text};
+      const std::vector<std::string> &lines = wrapped_item_lines(i, text_width);
 
       // Prepare styled text mapping if needed
       bool has_styled = !item.styled_text.empty();
@@ -3975,11 +5481,8 @@ class TextList : public Widget {
       int base_indent = item.level * indent_per_level;
       int text_width = width - base_indent - marker_width;
 
-      std::vector<std::string> lines;
-      if (word_wrap && text_width > 0)
-        lines = wrap_text(item.text, text_width);
-      else
-        lines = {item.text};
+      // Hit-testing reuses the same wrap layout the renderer drew
+      const std::vector<std::string> &lines = wrapped_item_lines(i, text_width);
 
       int item_char_offset = 0;
       for (int li = 0; li < (int)lines.size(); ++li) {
@@ -4034,6 +5537,41 @@ class TextList : public Widget {
     }
   }
 
+  /// @brief Per-item wrap layout reused across frames, keyed on the wrap
+  /// input (item text and effective text width) so direct mutation of the
+  /// public items vector still invalidates correctly
+  struct ItemWrapCache {
+    std::string text;
+    int text_width = -1;
+    bool wrap_on = false;
+    bool valid = false;
+    std::vector<std::string> lines;
+  };
+  mutable std::vector<ItemWrapCache> wrap_cache_;
+
+  const std::vector<std::string> &wrapped_item_lines(size_t i,
+                                                     int text_width) const {
+    if (wrap_cache_.size() != items.size()) {
+      wrap_cache_.assign(items.size(), ItemWrapCache{});
+    }
+    ItemWrapCache &entry = wrap_cache_[i];
+    bool wrap_on = word_wrap && text_width > 0;
+    if (entry.valid && entry.wrap_on == wrap_on &&
+        entry.text_width == text_width && entry.text == items[i].text) {
+      return entry.lines;
+    }
+    if (wrap_on) {
+      entry.lines = wrap_text(items[i].text, text_width);
+    } else {
+      entry.lines = {items[i].text};
+    }
+    entry.text = items[i].text;
+    entry.text_width = text_width;
+    entry.wrap_on = wrap_on;
+    entry.valid = true;
+    return entry.lines;
+  }
+
   std::vector<std::string> wrap_text(const std::string &input,
                                      int max_width) const {
     std::vector<std::string> result;
@@ -4114,20 +5652,29 @@ class Button : public Widget {
       Alignment::Center;  ///< Text alignment within the button
 
   void render(Buffer &buffer) override {
-    // 1. Resolve visual state
-    Color current_bg = bg_color.resolve(Theme::current().panel_bg);
-    Color current_fg =
-        text_color.is_default ? Color::contrast_color(current_bg) : text_color;
-
-    if (focused_) {
-      Color focus = focus_color.resolve(Theme::current().primary);
-      current_bg = pressed_ ? current_fg : focus;
-      current_fg = pressed_ ? current_bg : Color::contrast_color(focus);
-    } else if (hovered_) {
-      Color hover = hover_color.resolve(Theme::current().hover);
-      current_bg = pressed_ ? current_fg : hover;
-      current_fg = pressed_ ? current_bg : Color::contrast_color(hover);
-    }
+    // 1. Resolve visual state (cached until the theme, an override color
+    // or the interaction state changes)
+    uint32_t state = (focused_ ? 1u : 0u) | (hovered_ ? 2u : 0u) |
+                     (pressed_ ? 4u : 0u);
+    const ButtonStyle &style = style_cache_.get(
+        {bg_color, hover_color, focus_color, text_color}, state, [&] {
+          ButtonStyle s;
+          s.bg = bg_color.resolve(Theme::current().panel_bg);
+          s.fg = text_color.is_default ? Color::contrast_color(s.bg)
+                                       : text_color;
+          if (focused_) {
+            Color focus = focus_color.resolve(Theme::current().primary);
+            s.bg = pressed_ ? s.fg : focus;
+            s.fg = pressed_ ? s.bg : Color::contrast_color(focus);
+          } else if (hovered_) {
+            Color hover = hover_color.resolve(Theme::current().hover);
+            s.bg = pressed_ ? s.fg : hover;
+            s.fg = pressed_ ? s.bg : Color::contrast_color(hover);
+          }
+          return s;
+        });
+    Color current_bg = style.bg;
+    Color current_fg = style.fg;
 
     // 2. Fill Background
     for (int dy = 0; dy < height; ++dy) {
@@ -4141,7 +5688,8 @@ class Button : public Widget {
     }
 
     // 3. Render Text Label
-    std::vector<CharInfo> chars = prepare_text_for_render(label_);
+    auto chars_ref = prepare_text_cached(label_);
+    const std::vector<CharInfo> &chars = *chars_ref;
     int label_display_width = 0;
     for (const auto &ci : chars) label_display_width += ci.display_width;
 
@@ -4252,31 +5800,100 @@ class Button : public Widget {
   std::function<void()> on_click_;
   bool active_ = false;   // Mouse down started here
   bool pressed_ = false;  // Currently visually pressed;
+
+  /// @brief Theme-resolved colors for the current interaction state
+  struct ButtonStyle {
+    Color bg;
+    Color fg;
+  };
+  StyleCache<ButtonStyle> style_cache_;
 };
 
-/// @brief Generic undo/redo history manager for text input widgets
-/// @tparam State The state type to track (e.g., InputState, TextAreaState)
-template <typename State>
-class UndoRedoHistory {
+/// @brief Delta-encoded undo/redo history manager for text input widgets.
+///
+/// The old history stored a full snapshot per operation, so long editing
+/// sessions on large documents carried hundreds of redundant copies. This
+/// version stores one delta per entry — (line, byte column, removed span,
+/// inserted span) — computed by diffing each push against a single mirror
+/// of the last recorded document, so memory scales with the edits rather
+/// than with edits times document size, and undo/redo splice the delta
+/// into the caller's document in place in O(delta). Adjacent
+/// single-character typing (and backspace runs) coalesce into one entry,
+/// and the history enforces both an entry cap and a configurable byte
+/// budget by evicting the oldest entries.
+///
+/// The document model is the widgets' own: a vector of logical lines
+/// (Input adapts its single-line value through the string overloads).
+class DeltaUndoHistory {
  public:
   static constexpr size_t MAX_HISTORY = 100;
+  static constexpr size_t kDefaultMemoryBudget = 16 * 1024 * 1024;
 
-  /// @brief Push a new state to the history
-  /// @param state The state to save
-  void push(const State &state) {
-    // If we're not at the end of history, truncate redo states
-    if (current_idx_ < history_.size()) {
-      history_.erase(history_.begin() + current_idx_, history_.end());
+  /// @brief Cursor payload carried with every recorded state
+  struct Cursor {
+    int x = 0;
+    int y = 0;
+  };
+
+  /// @brief Record the document state before a modifying operation
+  /// @param doc The document as it is about to be modified
+  /// @param cursor The cursor belonging to that state
+  void push(const std::vector<std::string> &doc, Cursor cursor) {
+    bool truncated = false;
+    if (current_idx_ < entries_.size()) {
+      // Not at the end of history: drop the redo tail. The mirror sits at
+      // the state we undid to; rewind it one step so the new entry diffs
+      // against the last surviving state.
+      if (current_idx_ > 0) {
+        apply(mirror_, entries_[current_idx_].delta, /*reverse=*/true);
+      }
+      while (entries_.size() > current_idx_) {
+        total_bytes_ -= entries_.back().bytes;
+        entries_.pop_back();
+      }
+      truncated = true;
+    }
+
+    if (entries_.empty()) {
+      // Base entry: states before it are unreachable, so it carries no
+      // delta — only the cursor and the mirror seed (the one full copy
+      // this history ever holds)
+      entries_.push_back({Delta{}, cursor, 0});
+      mirror_ = doc;
+      current_idx_ = 1;
+      last_was_push_ = true;
+      return;
     }
 
-    // Add new state
-    history_.push_back(state);
+    Delta delta = diff(mirror_, doc);
+    apply(mirror_, delta, /*reverse=*/false);
 
-    // Enforce max history size
-    if (history_.size() > MAX_HISTORY) {
-      history_.erase(history_.begin());
-    } else {
-      current_idx_++;
+    // Coalesce typing/backspace runs into the newest entry. Only merge
+    // consecutive pushes (no undo/redo or truncation in between) and
+    // never into the delta-less base entry.
+    if (!truncated && last_was_push_ && entries_.size() > 1 &&
+        try_coalesce(entries_.back(), delta, cursor)) {
+      last_was_push_ = true;
+      return;
+    }
+
+    entries_.push_back({std::move(delta), cursor, 0});
+    entries_.back().bytes = delta_bytes(entries_.back().delta);
+    total_bytes_ += entries_.back().bytes;
+    current_idx_ = entries_.size();
+    last_was_push_ = true;
+
+    // Enforce the entry cap and byte budget by evicting the oldest
+    // entries; the new base entry's delta becomes unreachable and is
+    // released
+    while (current_idx_ > 2 && (entries_.size() > MAX_HISTORY ||
+                                total_bytes_ > memory_budget_)) {
+      total_bytes_ -= entries_.front().bytes;
+      entries_.pop_front();
+      total_bytes_ -= entries_.front().bytes;
+      entries_.front().delta = Delta{};
+      entries_.front().bytes = 0;
+      --current_idx_;
     }
   }
 
@@ -4284,47 +5901,235 @@ class UndoRedoHistory {
   bool can_undo() const { return current_idx_ > 0; }
 
   /// @brief Check if redo is possible
-  bool can_redo() const { return current_idx_ < history_.size(); }
+  bool can_redo() const { return current_idx_ + 1 < entries_.size(); }
 
-  /// @brief Undo to previous state
-  /// @param current The current state (saved before returning previous)
-  /// @return The previous state, or nullopt if no history
-  std::optional<State> undo(const State &current) {
+  /// @brief Step back one state, splicing the reverse delta into doc
+  /// @param doc The caller's document, modified in place
+  /// @param cursor The caller's current cursor (recorded for redo)
+  /// @return The cursor of the restored state, or nullopt at history start
+  std::optional<Cursor> undo(std::vector<std::string> &doc, Cursor cursor) {
     if (!can_undo()) return std::nullopt;
 
-    // If at the end of history, save current state for redo
-    if (current_idx_ == history_.size()) {
-      history_.push_back(current);
+    // First undo from an unrecorded present: record it so redo can return.
+    // The last keystroke of a typing run always lives here (push happens
+    // before each edit), so merge it into the run's entry when it
+    // continues one — otherwise one undo would only revert that keystroke.
+    if (current_idx_ == entries_.size()) {
+      Delta delta = diff(mirror_, doc);
+      apply(mirror_, delta, /*reverse=*/false);
+      if (last_was_push_ && entries_.size() > 1 &&
+          try_coalesce(entries_.back(), delta, cursor)) {
+        --current_idx_;
+      } else {
+        entries_.push_back({std::move(delta), cursor, 0});
+        entries_.back().bytes = delta_bytes(entries_.back().delta);
+        total_bytes_ += entries_.back().bytes;
+      }
     }
 
-    current_idx_--;
-    return history_[current_idx_];
+    --current_idx_;
+    apply(doc, entries_[current_idx_ + 1].delta, /*reverse=*/true);
+    apply(mirror_, entries_[current_idx_ + 1].delta, /*reverse=*/true);
+    last_was_push_ = false;
+    return entries_[current_idx_].cursor;
   }
 
-  /// @brief Redo to next state
-  /// @return The next state, or nullopt if no redo available
-  std::optional<State> redo() {
+  /// @brief Step forward one state, splicing the forward delta into doc
+  /// @param doc The caller's document, modified in place
+  /// @return The cursor of the restored state, or nullopt at history end
+  std::optional<Cursor> redo(std::vector<std::string> &doc) {
     if (!can_redo()) return std::nullopt;
 
-    current_idx_++;
-    if (current_idx_ < history_.size()) {
-      return history_[current_idx_];
-    }
-    return std::nullopt;
+    ++current_idx_;
+    apply(doc, entries_[current_idx_].delta, /*reverse=*/false);
+    apply(mirror_, entries_[current_idx_].delta, /*reverse=*/false);
+    last_was_push_ = false;
+    return entries_[current_idx_].cursor;
+  }
+
+  // Single-line document adapters for Input
+
+  /// @brief push() for a single-line document
+  void push(const std::string &value, int cursor_x) {
+    push(std::vector<std::string>{value}, {cursor_x, 0});
+  }
+
+  /// @brief undo() for a single-line document
+  std::optional<Cursor> undo(std::string &value, int cursor_x) {
+    std::vector<std::string> doc{std::move(value)};
+    auto cursor = undo(doc, {cursor_x, 0});
+    value = doc.empty() ? std::string() : std::move(doc[0]);
+    return cursor;
+  }
+
+  /// @brief redo() for a single-line document
+  std::optional<Cursor> redo(std::string &value) {
+    std::vector<std::string> doc{std::move(value)};
+    auto cursor = redo(doc);
+    value = doc.empty() ? std::string() : std::move(doc[0]);
+    return cursor;
   }
 
   /// @brief Clear all history
   void clear() {
-    history_.clear();
+    entries_.clear();
+    mirror_.clear();
     current_idx_ = 0;
+    total_bytes_ = 0;
+    last_was_push_ = false;
   }
 
   /// @brief Check if history is empty
-  bool empty() const { return history_.empty(); }
+  bool empty() const { return entries_.empty(); }
+
+  /// @brief Set the byte budget for retained deltas; evicts lazily on the
+  /// next push
+  void set_memory_budget(size_t bytes) { memory_budget_ = bytes; }
+
+  /// @brief Approximate bytes held by retained deltas
+  size_t memory_use() const { return total_bytes_; }
 
  private:
-  std::vector<State> history_;
+  /// @brief One edit: lines [line, line+removed.size()) became inserted.
+  /// When a single line changed, removed/inserted shrink to the differing
+  /// byte span at column col so a keystroke costs a few bytes, not a line.
+  struct Delta {
+    size_t line = 0;
+    size_t col = 0;
+    bool char_edit = false;  ///< removed/inserted are spans within one line
+    std::vector<std::string> removed;
+    std::vector<std::string> inserted;
+
+    bool empty() const { return removed.empty() && inserted.empty(); }
+  };
+
+  struct Entry {
+    Delta delta;  ///< Transforms the previous state into this one
+    Cursor cursor;
+    size_t bytes = 0;
+  };
+
+  static size_t delta_bytes(const Delta &delta) {
+    size_t n = sizeof(Entry);
+    for (const auto &s : delta.removed) n += s.size();
+    for (const auto &s : delta.inserted) n += s.size();
+    return n;
+  }
+
+  /// @brief Line-granular diff via common prefix/suffix, refined to a
+  /// byte span when exactly one line changed
+  static Delta diff(const std::vector<std::string> &before,
+                    const std::vector<std::string> &after) {
+    Delta d;
+    size_t prefix = 0;
+    size_t max_prefix = std::min(before.size(), after.size());
+    while (prefix < max_prefix && before[prefix] == after[prefix]) ++prefix;
+    size_t suffix = 0;
+    size_t max_suffix = max_prefix - prefix;
+    while (suffix < max_suffix &&
+           before[before.size() - 1 - suffix] ==
+               after[after.size() - 1 - suffix]) {
+      ++suffix;
+    }
+    d.line = prefix;
+    d.removed.assign(before.begin() + prefix, before.end() - suffix);
+    d.inserted.assign(after.begin() + prefix, after.end() - suffix);
+
+    if (d.removed.size() == 1 && d.inserted.size() == 1) {
+      // Shrink to the differing byte span within the line
+      const std::string &r = d.removed[0];
+      const std::string &i = d.inserted[0];
+      size_t p = 0;
+      size_t max_p = std::min(r.size(), i.size());
+      while (p < max_p && r[p] == i[p]) ++p;
+      size_t s = 0;
+      size_t max_s = max_p - p;
+      while (s < max_s && r[r.size() - 1 - s] == i[i.size() - 1 - s]) ++s;
+      d.col = p;
+      d.char_edit = true;
+      std::string removed_span = r.substr(p, r.size() - s - p);
+      std::string inserted_span = i.substr(p, i.size() - s - p);
+      d.removed.clear();
+      d.inserted.clear();
+      if (!removed_span.empty()) d.removed.push_back(std::move(removed_span));
+      if (!inserted_span.empty())
+        d.inserted.push_back(std::move(inserted_span));
+    }
+    return d;
+  }
+
+  /// @brief Splice a delta into doc, forwards or in reverse; O(delta)
+  static void apply(std::vector<std::string> &doc, const Delta &delta,
+                    bool reverse) {
+    if (delta.empty()) return;
+    const std::vector<std::string> &out =
+        reverse ? delta.inserted : delta.removed;
+    const std::vector<std::string> &in =
+        reverse ? delta.removed : delta.inserted;
+    if (delta.char_edit) {
+      if (delta.line >= doc.size()) return;  // Defensive: never out of sync
+      std::string &target = doc[delta.line];
+      size_t out_len = out.empty() ? 0 : out[0].size();
+      if (delta.col > target.size() ||
+          out_len > target.size() - delta.col) {
+        return;
+      }
+      target.replace(delta.col, out_len, in.empty() ? std::string() : in[0]);
+    } else {
+      if (delta.line > doc.size() ||
+          out.size() > doc.size() - delta.line) {
+        return;
+      }
+      doc.erase(doc.begin() + delta.line,
+                doc.begin() + delta.line + out.size());
+      doc.insert(doc.begin() + delta.line, in.begin(), in.end());
+    }
+  }
+
+  /// @brief Merge a new char-level delta into the newest entry when it
+  /// continues a typing run (insert right after the previous insert) or a
+  /// backspace run (remove right before the previous removal)
+  bool try_coalesce(Entry &last, const Delta &next, Cursor cursor) {
+    Delta &prev = last.delta;
+    if (!prev.char_edit || !next.char_edit || prev.line != next.line) {
+      return false;
+    }
+    size_t prev_ins = prev.inserted.empty() ? 0 : prev.inserted[0].size();
+
+    // Typing: pure insert continuing at the end of the previous insert
+    if (next.removed.empty() && !next.inserted.empty() &&
+        next.inserted[0].size() <= 8 &&
+        next.col == prev.col + prev_ins) {
+      if (prev.inserted.empty()) prev.inserted.push_back(std::string());
+      prev.inserted[0] += next.inserted[0];
+      total_bytes_ += next.inserted[0].size();
+      last.bytes += next.inserted[0].size();
+      last.cursor = cursor;
+      return true;
+    }
+
+    // Backspace: pure removal ending where the previous removal began,
+    // only while the previous entry is itself removal-only
+    if (next.inserted.empty() && !next.removed.empty() && prev_ins == 0 &&
+        next.removed[0].size() <= 8 &&
+        next.col + next.removed[0].size() == prev.col) {
+      if (prev.removed.empty()) prev.removed.push_back(std::string());
+      prev.removed[0] = next.removed[0] + prev.removed[0];
+      prev.col = next.col;
+      total_bytes_ += next.removed[0].size();
+      last.bytes += next.removed[0].size();
+      last.cursor = cursor;
+      return true;
+    }
+    return false;
+  }
+
+  std::deque<Entry> entries_;
+  std::vector<std::string> mirror_;  ///< Document at the newest recorded state
   size_t current_idx_ = 0;
+  size_t total_bytes_ = 0;
+  size_t memory_budget_ = kDefaultMemoryBudget;
+  bool last_was_push_ = false;
 };
 
 /// @brief An interactive text input field
@@ -4365,6 +6170,11 @@ class Input : public Widget
 
   std::function<void(std::string)> on_change;
 
+  /// @brief Cap the bytes the undo history retains in edit deltas
+  void set_undo_memory_budget(size_t bytes) {
+    undo_history_.set_memory_budget(bytes);
+  }
+
   bool is_valid() const {
     if (regex_pattern.empty()) return true;
     try {
@@ -4380,24 +6190,45 @@ class Input : public Widget
     bool focused = has_focus();
     bool valid = is_valid();
 
-    // Base Style
-    Color base_fg = fg_color.resolve(Theme::current().input_fg);
-    Color base_bg = bg_color.resolve(Theme::current().input_bg);
-
-    // Focused Style overrides Base
-    if (focused) {
-      if (!focused_fg_color.is_default) base_fg = focused_fg_color;
-      if (!focused_bg_color.is_default) base_bg = focused_bg_color;
-    }
+    // Full style set, cached until the theme, an override color or the
+    // focus/error state changes
+    bool show_error = !valid && !value_.empty();
+    uint32_t state = (focused ? 1u : 0u) | (show_error ? 2u : 0u);
+    const InputStyle &style = style_cache_.get(
+        {fg_color, bg_color, focused_fg_color, focused_bg_color,
+         error_fg_color, error_bg_color, placeholder_color, cursor_color},
+        state, [&] {
+          InputStyle s;
+          // Base Style
+          s.base_fg = fg_color.resolve(Theme::current().input_fg);
+          s.base_bg = bg_color.resolve(Theme::current().input_bg);
+
+          // Focused Style overrides Base
+          if (focused) {
+            if (!focused_fg_color.is_default) s.base_fg = focused_fg_color;
+            if (!focused_bg_color.is_default) s.base_bg = focused_bg_color;
+          }
 
-    // Text Color (inherits base, but changes on error)
-    Color text_fg = base_fg;
-    Color text_bg = base_bg;
+          // Text Color (inherits base, but changes on error)
+          s.text_fg = s.base_fg;
+          s.text_bg = s.base_bg;
+          if (show_error) {
+            if (!error_fg_color.is_default) s.text_fg = error_fg_color;
+            if (!error_bg_color.is_default) s.text_bg = error_bg_color;
+          }
 
-    if (!valid && !value_.empty()) {
-      if (!error_fg_color.is_default) text_fg = error_fg_color;
-      if (!error_bg_color.is_default) text_bg = error_bg_color;
-    }
+          s.placeholder_fg =
+              placeholder_color.resolve(Theme::current().input_placeholder);
+          s.selection_bg = Theme::current().selection;
+          s.selection_fg = Color::contrast_color(s.selection_bg);
+          s.cursor_bg = cursor_color.resolve(Theme::current().primary);
+          s.cursor_fg = Theme::current().background;
+          return s;
+        });
+    Color base_fg = style.base_fg;
+    Color base_bg = style.base_bg;
+    Color text_fg = style.text_fg;
+    Color text_bg = style.text_bg;
 
     // Pre-compute UTF-8 characters for value
     std::vector<CharInfo> value_chars =
@@ -4418,8 +6249,8 @@ class Input : public Widget
     }
 
     // Pre-compute placeholder chars
-    std::vector<CharInfo> placeholder_chars =
-        TextHelper::prepare_text_for_render(placeholder);
+    auto placeholder_ref = TextHelper::prepare_text_cached(placeholder);
+    const std::vector<CharInfo> &placeholder_chars = *placeholder_ref;
 
     int text_y = height / 2;  // Vertical Center as requested for flexed inputs
 
@@ -4447,8 +6278,7 @@ class Input : public Widget
           Cell cell;
           cell.bg_color = base_bg;
           cell.content = ci.content;
-          cell.fg_color =
-              placeholder_color.resolve(Theme::current().input_placeholder);
+          cell.fg_color = style.placeholder_fg;
 
           buffer.set(x + screen_dx, y + dy, cell);
           if (ci.display_width == 2 && screen_dx + 1 < width) {
@@ -4478,8 +6308,8 @@ class Input : public Widget
             // Check if this character is selected
             bool in_selection = selection_state_.is_selected((int)v_idx);
             if (in_selection) {
-              cell.bg_color = Theme::current().selection;
-              cell.fg_color = Color::contrast_color(cell.bg_color);
+              cell.bg_color = style.selection_bg;
+              cell.fg_color = style.selection_fg;
             } else {
               cell.bg_color = text_bg;
               cell.fg_color = text_fg;
@@ -4520,10 +6350,9 @@ class Input : public Widget
       if (focused) {
         int cursor_screen_x = cursor_visual_x - view_offset_;
         if (cursor_screen_x >= 0 && cursor_screen_x < width) {
-          Color cc = cursor_color.resolve(Theme::current().primary);
           Cell c_cursor;
-          c_cursor.bg_color = cc;
-          c_cursor.fg_color = Theme::current().background;
+          c_cursor.bg_color = style.cursor_bg;
+          c_cursor.fg_color = style.cursor_fg;
           c_cursor.content = " ";
           if (cursor_char_pos_ < value_chars.size()) {
             c_cursor.content = value_chars[cursor_char_pos_].content;
@@ -4620,9 +6449,9 @@ class Input : public Widget
 
       // Handle Undo (Ctrl+Z)
       if (event.is_undo()) {
-        auto prev_state = undo_history_.undo(get_current_state());
-        if (prev_state) {
-          restore_state(*prev_state);
+        auto cursor = undo_history_.undo(value_, (int)cursor_char_pos_);
+        if (cursor) {
+          finish_history_restore(*cursor);
           if (on_change) on_change(value_);
         }
         return true;
@@ -4630,9 +6459,9 @@ class Input : public Widget
 
       // Handle Redo (Ctrl+Shift+Z or Ctrl+Y)
       if (event.is_redo()) {
-        auto next_state = undo_history_.redo();
-        if (next_state) {
-          restore_state(*next_state);
+        auto cursor = undo_history_.redo(value_);
+        if (cursor) {
+          finish_history_restore(*cursor);
           if (on_change) on_change(value_);
         }
         return true;
@@ -4786,9 +6615,8 @@ class Input : public Widget
       return true;
     }
 
-    // Handle Paste event (bracketed paste)
-    if (has_focus() && event.type == EventType::Paste &&
-        !event.paste_text.empty()) {
+    // Handle Paste events and batched plain-text runs: one splice each
+    if (has_focus() && event.is_text_event() && !event.paste_text.empty()) {
       save_undo_state();
       if (has_selection()) delete_selection();
 
@@ -4859,22 +6687,24 @@ class Input : public Widget
  private:
   std::string value_;
   size_t cursor_char_pos_ = 0;  // Cursor position in characters (not bytes)
-  int view_offset_ = 0;         // Horizontal scroll offset (in visual cells)
 
-  // Undo/Redo state
-  struct InputState {
-    std::string value;
-    size_t cursor_pos;
+  /// @brief Theme-resolved colors for the current focus/error state
+  struct InputStyle {
+    Color base_fg, base_bg;
+    Color text_fg, text_bg;
+    Color placeholder_fg;
+    Color selection_bg, selection_fg;
+    Color cursor_bg, cursor_fg;
   };
-  UndoRedoHistory<InputState> undo_history_;
+  StyleCache<InputStyle> style_cache_;
+  int view_offset_ = 0;         // Horizontal scroll offset (in visual cells)
 
-  /// @brief Get current state for undo/redo
-  InputState get_current_state() const { return {value_, cursor_char_pos_}; }
+  // Undo/Redo state
+  DeltaUndoHistory undo_history_;
 
-  /// @brief Restore state from undo/redo
-  void restore_state(const InputState &state) {
-    value_ = state.value;
-    cursor_char_pos_ = state.cursor_pos;
+  /// @brief Fix up widget state after the history spliced value_ in place
+  void finish_history_restore(DeltaUndoHistory::Cursor cursor) {
+    cursor_char_pos_ = cursor.x < 0 ? 0 : (size_t)cursor.x;
     // Clamp cursor position
     size_t char_count = count_chars();
     if (cursor_char_pos_ > char_count) cursor_char_pos_ = char_count;
@@ -4883,7 +6713,9 @@ class Input : public Widget
   }
 
   /// @brief Save current state before a modifying operation
-  void save_undo_state() { undo_history_.push(get_current_state()); }
+  void save_undo_state() {
+    undo_history_.push(value_, (int)cursor_char_pos_);
+  }
 
   void update_view_offset() {
     if (width <= 0) {
@@ -5094,6 +6926,12 @@ class TextArea : public Widget {
   std::function<void(std::string)> on_change;
   std::function<void(int, int)> on_cursor_move;
 
+  /// @brief Cap the bytes the undo history retains in edit deltas; the
+  /// oldest entries are evicted once the budget is exceeded
+  void set_undo_memory_budget(size_t bytes) {
+    undo_history_.set_memory_budget(bytes);
+  }
+
   void on_blur() override {
     clear_selection();
     Widget::on_blur();
@@ -5161,47 +6999,10 @@ class TextArea : public Widget {
 
   void recalculate_virtual_lines() {
     virtual_lines_.clear();
-    int ln_width = get_line_number_width();
-    int text_width = width - ln_width;
-    if (show_scrollbar) text_width -= 1;
-    if (text_width <= 0) text_width = 1;
-
-    if (!word_wrap) {
-      for (size_t i = 0; i < lines_.size(); ++i) {
-        auto chars = prepare_text_for_render(lines_[i]);
-        virtual_lines_.push_back({i, 0, (int)chars.size(), false});
-      }
-      return;
-    }
-
+    last_wrap_text_width_ = wrap_text_width();
+    virtual_lines_.reserve(lines_.size());
     for (size_t i = 0; i < lines_.size(); ++i) {
-      auto chars = prepare_text_for_render(lines_[i]);
-      if (chars.empty()) {
-        virtual_lines_.push_back({i, 0, 0, false});
-        continue;
-      }
-
-      int current_line_visual_width = 0;
-      int start_char = 0;
-      bool is_cont = false;
-
-      for (int c_idx = 0; c_idx < (int)chars.size(); ++c_idx) {
-        int cw = chars[c_idx].display_width;
-        if (current_line_visual_width + cw > text_width &&
-            current_line_visual_width > 0) {
-          // Wrap
-          virtual_lines_.push_back(
-              {i, start_char, c_idx - start_char, is_cont});
-          start_char = c_idx;
-          current_line_visual_width = cw;
-          is_cont = true;
-        } else {
-          current_line_visual_width += cw;
-        }
-      }
-      // Last segment
-      virtual_lines_.push_back(
-          {i, start_char, (int)chars.size() - start_char, is_cont});
+      wrap_line(i, last_wrap_text_width_, virtual_lines_);
     }
   }
 
@@ -5268,7 +7069,7 @@ class TextArea : public Widget {
 
             int text_pos = dx - (ln_width - (int)ln_str.length() - 1);
             if (text_pos >= 0 && text_pos < (int)ln_str.length()) {
-              cell.content = ln_str.substr(text_pos, 1);
+              cell.content = std::string_view(ln_str).substr(text_pos, 1);
             }
             buffer.set(x + dx, sy, cell);
           }
@@ -5553,9 +7354,9 @@ class TextArea : public Widget {
 
       // Handle Undo (Ctrl+Z)
       if (event.is_undo()) {
-        auto prev_state = undo_history_.undo(get_current_state());
-        if (prev_state) {
-          restore_state(*prev_state);
+        auto cursor = undo_history_.undo(lines_, {cursor_x_, cursor_y_});
+        if (cursor) {
+          finish_history_restore(*cursor);
           if (on_change) on_change(get_text());
         }
         return true;
@@ -5563,9 +7364,9 @@ class TextArea : public Widget {
 
       // Handle Redo (Ctrl+Shift+Z or Ctrl+Y)
       if (event.is_redo()) {
-        auto next_state = undo_history_.redo();
-        if (next_state) {
-          restore_state(*next_state);
+        auto cursor = undo_history_.redo(lines_);
+        if (cursor) {
+          finish_history_restore(*cursor);
           if (on_change) on_change(get_text());
         }
         return true;
@@ -5584,9 +7385,8 @@ class TextArea : public Widget {
         if (has_selection()) {
           save_undo_state();
           copy_to_clipboard(get_selected_text());
-          delete_selection();
+          delete_selection();  // Splices the wrap structures itself
           needs_recalc_max_width_ = true;
-          recalculate_virtual_lines();
           if (on_change) on_change(get_text());
         }
         ensure_cursor_visible();
@@ -5600,6 +7400,7 @@ class TextArea : public Widget {
       if (!text.empty()) {
         save_undo_state();
         if (has_selection()) delete_selection();
+        int paste_start_y = cursor_y_;
 
         size_t i = 0;
         while (i < text.size()) {
@@ -5630,18 +7431,18 @@ class TextArea : public Widget {
         }
 
         needs_recalc_max_width_ = true;
-        recalculate_virtual_lines();
+        splice_virtual_lines(paste_start_y, 1, cursor_y_ - paste_start_y + 1);
         ensure_cursor_visible();
         if (on_change) on_change(get_text());
       }
       return true;
     }
 
-    // Handle Paste event (bracketed paste)
-    if (has_focus() && event.type == EventType::Paste &&
-        !event.paste_text.empty()) {
+    // Handle Paste events and batched plain-text runs: one splice each
+    if (has_focus() && event.is_text_event() && !event.paste_text.empty()) {
       save_undo_state();
       if (has_selection()) delete_selection();
+      int paste_start_y = cursor_y_;
 
       // Split pasted text by lines
       std::vector<std::string> paste_lines;
@@ -5703,7 +7504,7 @@ class TextArea : public Widget {
 
       clear_selection();
       needs_recalc_max_width_ = true;
-      recalculate_virtual_lines();
+      splice_virtual_lines(paste_start_y, 1, cursor_y_ - paste_start_y + 1);
       ensure_cursor_visible();
 
       if (on_change) on_change(get_text());
@@ -5725,7 +7526,7 @@ class TextArea : public Widget {
           cursor_x_ += tab_size;
 
           needs_recalc_max_width_ = true;
-          recalculate_virtual_lines();
+          splice_virtual_lines(cursor_y_, 1, 1);
           ensure_cursor_visible();
           if (on_change) on_change(get_text());
           return true;
@@ -5758,9 +7559,8 @@ class TextArea : public Widget {
       if (event.ctrl && event.shift && (event.key == 'x' || event.key == 'X')) {
         if (has_selection()) {
           copy_to_clipboard(get_selected_text());
-          delete_selection();
+          delete_selection();  // Splices the wrap structures itself
           needs_recalc_max_width_ = true;
-          recalculate_virtual_lines();
           if (on_change) on_change(get_text());
         }
         ensure_cursor_visible();
@@ -5892,6 +7692,8 @@ class TextArea : public Widget {
         lines_.insert(lines_.begin() + cursor_y_ + 1, next_line);
         cursor_y_++;
         cursor_x_ = 0;
+        clear_selection();  // Prevent stale anchor from forming a selection
+        splice_virtual_lines(cursor_y_ - 1, 1, 2);
         changed = true;
       } else if (event.is_backspace()) {  // Backspace
         save_undo_state();
@@ -5904,6 +7706,7 @@ class TextArea : public Widget {
           size_t next_byte = char_to_byte_pos(cursor_y_, cursor_x_);
           l.erase(byte_idx, next_byte - byte_idx);
           cursor_x_--;
+          splice_virtual_lines(cursor_y_, 1, 1);
           changed = true;
         } else if (cursor_y_ > 0) {
           cursor_x_ =
@@ -5911,6 +7714,8 @@ class TextArea : public Widget {
           lines_[cursor_y_ - 1] += lines_[cursor_y_];
           lines_.erase(lines_.begin() + cursor_y_);
           cursor_y_--;
+          clear_selection();  // Prevent stale anchor from forming a selection
+          splice_virtual_lines(cursor_y_, 2, 1);
           changed = true;
         }
       } else if (event.is_delete()) {  // Delete
@@ -5925,10 +7730,13 @@ class TextArea : public Widget {
             size_t byte_idx = char_to_byte_pos(cursor_y_, cursor_x_);
             size_t next_byte = char_to_byte_pos(cursor_y_, cursor_x_ + 1);
             l.erase(byte_idx, next_byte - byte_idx);
+            splice_virtual_lines(cursor_y_, 1, 1);
             changed = true;
           } else if (cursor_y_ < (int)lines_.size() - 1) {
             lines_[cursor_y_] += lines_[cursor_y_ + 1];
             lines_.erase(lines_.begin() + cursor_y_ + 1);
+            clear_selection();  // Prevent stale anchor from forming a selection
+            splice_virtual_lines(cursor_y_, 2, 1);
             changed = true;
           }
         }
@@ -5942,12 +7750,11 @@ class TextArea : public Widget {
         l.insert(byte_idx, 1, (char)event.key);
         cursor_x_++;
         clear_selection();  // Prevent stale anchor from forming a selection
+        splice_virtual_lines(cursor_y_, 1, 1);
         changed = true;
       }
 
       if (changed) {
-        needs_recalc_max_width_ = true;
-        recalculate_virtual_lines();
         if (on_change) on_change(get_text());
       }
 
@@ -6004,8 +7811,114 @@ class TextArea : public Widget {
     bool is_continuation;
   };
   std::vector<VirtualLine> virtual_lines_;
+  int last_wrap_text_width_ = -1;  ///< Width the current wrap was built for
   bool is_dragging_scrollbar_ = false;
 
+  /// @brief Text column budget the wrap structures are computed against
+  int wrap_text_width() const {
+    int text_width = width - get_line_number_width();
+    if (show_scrollbar) text_width -= 1;
+    return text_width <= 0 ? 1 : text_width;
+  }
+
+  /// @brief Append the wrap segments for one logical line to @p out
+  void wrap_line(size_t i, int text_width,
+                 std::vector<VirtualLine> &out) const {
+    auto chars = prepare_text_for_render(lines_[i]);
+    if (!word_wrap || chars.empty()) {
+      out.push_back({i, 0, (int)chars.size(), false});
+      return;
+    }
+
+    int current_line_visual_width = 0;
+    int start_char = 0;
+    bool is_cont = false;
+
+    for (int c_idx = 0; c_idx < (int)chars.size(); ++c_idx) {
+      int cw = chars[c_idx].display_width;
+      if (current_line_visual_width + cw > text_width &&
+          current_line_visual_width > 0) {
+        // Wrap
+        out.push_back({i, start_char, c_idx - start_char, is_cont});
+        start_char = c_idx;
+        current_line_visual_width = cw;
+        is_cont = true;
+      } else {
+        current_line_visual_width += cw;
+      }
+    }
+    // Last segment
+    out.push_back({i, start_char, (int)chars.size() - start_char, is_cont});
+  }
+
+  /// @brief First virtual-line entry at or after @p line (binary search;
+  /// entries are always sorted by logical line index)
+  std::vector<VirtualLine>::iterator v_lower_bound(size_t line) {
+    return std::lower_bound(
+        virtual_lines_.begin(), virtual_lines_.end(), line,
+        [](const VirtualLine &vl, size_t l) { return vl.logical_line_idx < l; });
+  }
+
+  /// @brief Incrementally update the wrap structures after an edit that
+  /// replaced @p old_count logical lines starting at @p first with
+  /// @p new_count lines. Only the affected lines are re-shaped; everything
+  /// else keeps its entries (indices shifted when lines were added or
+  /// removed). Falls back to a full recompute when the text width changed
+  /// under us (resize, line-number gutter growing a digit).
+  void splice_virtual_lines(size_t first, size_t old_count,
+                            size_t new_count) {
+    needs_recalc_max_width_ = true;  // Refined below when the edit grew a line
+    if (virtual_lines_.empty() || last_wrap_text_width_ != wrap_text_width()) {
+      recalculate_virtual_lines();
+      return;
+    }
+
+    // Re-shape just the replacement lines
+    std::vector<VirtualLine> fresh;
+    for (size_t i = first; i < first + new_count && i < lines_.size(); ++i) {
+      wrap_line(i, last_wrap_text_width_, fresh);
+    }
+
+    auto lo = v_lower_bound(first);
+    auto hi = std::lower_bound(
+        lo, virtual_lines_.end(), first + old_count,
+        [](const VirtualLine &vl, size_t l) { return vl.logical_line_idx < l; });
+
+    // Shift entries past the edit before iterators are invalidated
+    long delta = (long)new_count - (long)old_count;
+    if (delta != 0) {
+      for (auto it = hi; it != virtual_lines_.end(); ++it) {
+        it->logical_line_idx += delta;
+      }
+    }
+
+    size_t lo_idx = lo - virtual_lines_.begin();
+    size_t hi_idx = hi - virtual_lines_.begin();
+    if (hi_idx - lo_idx == fresh.size()) {
+      // Same entry count (the common case for plain typing): overwrite
+      std::copy(fresh.begin(), fresh.end(), virtual_lines_.begin() + lo_idx);
+    } else {
+      virtual_lines_.erase(virtual_lines_.begin() + lo_idx,
+                           virtual_lines_.begin() + hi_idx);
+      virtual_lines_.insert(virtual_lines_.begin() + lo_idx, fresh.begin(),
+                            fresh.end());
+    }
+
+    // Keep the horizontal-extent cache usable without a full document
+    // scan: a longer edited line raises the max in place; anything else
+    // (shrink or removal) leaves the rescan flag set for render
+    if (!word_wrap && cached_max_visual_width_ != -1) {
+      int edited_max = 0;
+      for (size_t i = first; i < first + new_count && i < lines_.size(); ++i) {
+        edited_max = std::max(edited_max, calculate_line_width_fast(lines_[i]));
+      }
+      if (edited_max >= cached_max_visual_width_) {
+        cached_max_visual_width_ = edited_max;
+        needs_recalc_max_width_ = false;
+      }
+    }
+  }
+
   mutable int cached_max_visual_width_ = -1;
   mutable bool needs_recalc_max_width_ = true;
 
@@ -6048,23 +7961,12 @@ class TextArea : public Widget {
   int scroll_y_ = 0;
 
   // Undo/Redo state
-  struct TextAreaState {
-    std::vector<std::string> lines;
-    int cursor_x;
-    int cursor_y;
-  };
-  UndoRedoHistory<TextAreaState> undo_history_;
-
-  /// @brief Get current state for undo/redo
-  TextAreaState get_current_state() const {
-    return {lines_, cursor_x_, cursor_y_};
-  }
+  DeltaUndoHistory undo_history_;
 
-  /// @brief Restore state from undo/redo
-  void restore_state(const TextAreaState &state) {
-    lines_ = state.lines;
-    cursor_x_ = state.cursor_x;
-    cursor_y_ = state.cursor_y;
+  /// @brief Fix up widget state after the history spliced lines_ in place
+  void finish_history_restore(DeltaUndoHistory::Cursor cursor) {
+    cursor_x_ = cursor.x;
+    cursor_y_ = cursor.y;
     // Ensure at least one empty line
     if (lines_.empty()) lines_.push_back("");
     // Clamp cursor position
@@ -6080,7 +7982,9 @@ class TextArea : public Widget {
   }
 
   /// @brief Save current state before a modifying operation
-  void save_undo_state() { undo_history_.push(get_current_state()); }
+  void save_undo_state() {
+    undo_history_.push(lines_, {cursor_x_, cursor_y_});
+  }
 
   int get_line_number_width() const {
     if (!show_line_numbers) return 0;
@@ -6116,19 +8020,22 @@ class TextArea : public Widget {
   }
 
   int find_v_line(int logical_y, int char_x) {
-    for (int i = 0; i < (int)virtual_lines_.size(); ++i) {
-      const auto &vl = virtual_lines_[i];
-      if (vl.logical_line_idx == (size_t)logical_y) {
-        if (char_x >= vl.start_char_idx &&
-            char_x < vl.start_char_idx + vl.char_count)
+    // Entries are sorted by logical line, so jump straight to the line's
+    // first segment instead of scanning the whole document
+    auto it = v_lower_bound((size_t)logical_y);
+    for (; it != virtual_lines_.end() &&
+           it->logical_line_idx == (size_t)logical_y;
+         ++it) {
+      int i = (int)(it - virtual_lines_.begin());
+      if (char_x >= it->start_char_idx &&
+          char_x < it->start_char_idx + it->char_count)
+        return i;
+      // Also handle end of line
+      if (char_x == it->start_char_idx + it->char_count) {
+        // Check if last segment for this logical line
+        if (i == (int)virtual_lines_.size() - 1 ||
+            virtual_lines_[i + 1].logical_line_idx != (size_t)logical_y)
           return i;
-        // Also handle end of line
-        if (char_x == vl.start_char_idx + vl.char_count) {
-          // Check if last segment for this logical line
-          if (i == (int)virtual_lines_.size() - 1 ||
-              virtual_lines_[i + 1].logical_line_idx != (size_t)logical_y)
-            return i;
-        }
       }
     }
     return 0;
@@ -6250,6 +8157,16 @@ class TextArea : public Widget {
     int sx, sy, ex, ey;
     get_selection_range(sx, sy, ex, ey);
 
+    // Defensive: a stale anchor must never reach past the document
+    if (ey >= (int)lines_.size()) {
+      ey = (int)lines_.size() - 1;
+      ex = (int)prepare_text_for_render(lines_[ey]).size();
+    }
+    if (sy > ey || sy < 0) {
+      clear_selection();
+      return;
+    }
+
     if (sy == ey) {
       // Single line deletion
       size_t byte_start = char_to_byte_pos(sy, sx);
@@ -6272,6 +8189,7 @@ class TextArea : public Widget {
     auto chars = prepare_text_for_render(lines_[cursor_y_]);
     if (cursor_x_ > (int)chars.size()) cursor_x_ = (int)chars.size();
 
+    splice_virtual_lines((size_t)sy, (size_t)(ey - sy) + 1, 1);
     clear_selection();
   }
 
@@ -6387,18 +8305,57 @@ class Container : public Widget {
 
   /// @brief Add a child widget to the container
   /// @param widget The widget to add
-  void add(std::shared_ptr<Widget> widget) { children_.push_back(widget); }
+  void add(std::shared_ptr<Widget> widget) {
+    children_.push_back(widget);
+    layout_cache_valid_ = false;
+  }
 
   /// @brief Remove all children from the container
-  void clear_children() { children_.clear(); }
+  void clear_children() {
+    children_.clear();
+    layout_cache_valid_ = false;
+  }
+
+  /// @brief Drop this container's cached layout (and its descendants') so
+  /// the next layout() pass recomputes geometry even if the input
+  /// fingerprint matches. Needed only for changes the fingerprint cannot
+  /// see; rect, visibility, child-list and constraint changes — including
+  /// nested ones, which the pre-check update_responsive pass folds into
+  /// the hashed child fields — are detected automatically.
+  void invalidate_layout() {
+    layout_cache_valid_ = false;
+    for (auto &child : children_) {
+      if (auto cont = std::dynamic_pointer_cast<Container>(child)) {
+        cont->invalidate_layout();
+      }
+    }
+  }
 
   virtual void render(Buffer &buffer) override {
+    if (render_children_parallel(buffer, children_)) return;
+    Rect clip = buffer.current_clip();
     for (auto &child : children_) {
-      if (child->visible) {
-        buffer.push_clip({child->x, child->y, child->width, child->height});
+      if (!child->visible) continue;
+      Rect child_rect{child->x, child->y, child->width, child->height};
+      // Cull children entirely outside the active clip (damage) region,
+      // except overlays that render at screen-absolute coordinates
+      if (!child->renders_outside_bounds()) {
+        Rect vis = clip.intersect(child_rect);
+        if (vis.width <= 0 || vis.height <= 0) continue;
+      }
+      buffer.push_clip(child_rect);
+      if (g_frame_profiler.enabled) {
+        auto start = std::chrono::steady_clock::now();
+        child->render(buffer);
+        auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                      std::chrono::steady_clock::now() - start)
+                      .count();
+        g_frame_profiler.note_widget(child.get(), typeid(*child).name(),
+                                     (double)ns / 1e6);
+      } else {
         child->render(buffer);
-        buffer.pop_clip();
       }
+      buffer.pop_clip();
     }
   }
 
@@ -6409,6 +8366,76 @@ class Container : public Widget {
     return false;
   }
 
+  /// @brief Render children concurrently when it is safe to do so.
+  ///
+  /// Each child renders into a per-child scratch buffer on the render pool
+  /// and the results composite back in child order, so serial semantics are
+  /// preserved exactly. Falls back (returns false) unless parallel mode is
+  /// on, this is the outermost container of the frame, the profiler is off
+  /// (per-widget timings must stay attributable), and the visible children
+  /// occupy pairwise-disjoint regions with no overlay children — overlap
+  /// makes paint order observable, so those trees render serially.
+  /// @param buffer The target frame buffer
+  /// @param kids The child set to render
+  /// @return true if the children were rendered, false to use the serial path
+  bool render_children_parallel(
+      Buffer &buffer, const std::vector<std::shared_ptr<Widget>> &kids) {
+    if (!g_parallel_render || g_in_parallel_render ||
+        g_frame_profiler.enabled) {
+      return false;
+    }
+    Rect clip = buffer.current_clip();
+    std::vector<std::pair<Widget *, Rect>> jobs;
+    for (const auto &child : kids) {
+      if (!child || !child->visible) continue;
+      if (child->renders_outside_bounds()) return false;  // Paint-order bound
+      Rect vis =
+          clip.intersect({child->x, child->y, child->width, child->height});
+      if (vis.width <= 0 || vis.height <= 0) continue;  // Culled
+      jobs.emplace_back(child.get(), vis);
+    }
+    if (jobs.size() < 2) return false;
+    for (size_t i = 0; i < jobs.size(); ++i) {
+      for (size_t j = i + 1; j < jobs.size(); ++j) {
+        Rect overlap = jobs[i].second.intersect(jobs[j].second);
+        if (overlap.width > 0 && overlap.height > 0) return false;
+      }
+    }
+
+    // One full-size scratch buffer per child, reused across frames.
+    // Seeding the child's region from the frame buffer means a child that
+    // does not paint every cell sees exactly what the serial path would.
+    if (parallel_buffers_.size() < jobs.size()) {
+      parallel_buffers_.resize(jobs.size());
+    }
+    std::vector<std::function<void()>> tasks;
+    tasks.reserve(jobs.size());
+    for (size_t i = 0; i < jobs.size(); ++i) {
+      auto &scratch = parallel_buffers_[i];
+      if (!scratch || scratch->width() != buffer.width() ||
+          scratch->height() != buffer.height()) {
+        scratch = std::make_unique<Buffer>(buffer.width(), buffer.height());
+      }
+      Widget *child = jobs[i].first;
+      Rect vis = jobs[i].second;
+      Buffer *target = scratch.get();
+      tasks.push_back([child, vis, target, &buffer] {
+        bool was_parallel = g_in_parallel_render;
+        g_in_parallel_render = true;
+        target->copy_rect(buffer, vis);
+        target->push_clip(vis);
+        child->render(*target);
+        target->pop_clip();
+        g_in_parallel_render = was_parallel;
+      });
+    }
+    g_render_pool.run(tasks);
+    for (size_t i = 0; i < jobs.size(); ++i) {
+      buffer.copy_rect(*parallel_buffers_[i], jobs[i].second);
+    }
+    return true;
+  }
+
   /// @brief Recalculate layout of children. Must be implemented by subclasses.
   virtual void layout() = 0;
 
@@ -6476,6 +8503,80 @@ class Container : public Widget {
  protected:
   std::vector<std::shared_ptr<Widget>> children_;
 
+  /// @brief Per-child scratch buffers for render_children_parallel, kept
+  /// across frames so steady-state parallel frames allocate nothing
+  std::vector<std::unique_ptr<Buffer>> parallel_buffers_;
+
+  // Incremental layout: fingerprint of the last layout's inputs. When it
+  // matches, flex distribution and geometry writes are skipped and only the
+  // recursion into child containers runs (each checks its own fingerprint).
+  uint64_t layout_fingerprint_ = 0;
+  bool layout_cache_valid_ = false;
+
+  /// @brief Hash everything this container's layout depends on: its own
+  /// rect, the responsive screen categories, and each child's identity,
+  /// visibility, responsive config and size constraints
+  uint64_t compute_layout_fingerprint() const {
+    uint64_t h = 1469598103934665603ull;  // FNV-1a offset basis
+    auto mix = [&h](uint64_t v) {
+      h ^= v;
+      h *= 1099511628211ull;
+    };
+    mix((uint64_t)(uint32_t)x | ((uint64_t)(uint32_t)y << 32));
+    mix((uint64_t)(uint32_t)width | ((uint64_t)(uint32_t)height << 32));
+    mix(((uint64_t)g_screen_size << 2) | (uint64_t)g_screen_height_cat);
+    mix(children_.size());
+    for (const auto &child : children_) {
+      if (!child) continue;
+      mix((uint64_t) reinterpret_cast<uintptr_t>(child.get()));
+      uint64_t flags = (child->visible ? 1 : 0) |
+                       (child->is_responsive ? 2 : 0) |
+                       (child->responsive_width ? 4 : 0) |
+                       (child->responsive_height ? 8 : 0) |
+                       (child->visible_sm ? 16 : 0) |
+                       (child->visible_md ? 32 : 0) |
+                       (child->visible_lg ? 64 : 0) |
+                       (child->visible_h_sm ? 128 : 0) |
+                       (child->visible_h_md ? 256 : 0) |
+                       (child->visible_h_lg ? 512 : 0);
+      mix(flags);
+      mix((uint64_t)(uint32_t)child->fixed_width |
+          ((uint64_t)(uint32_t)child->fixed_height << 32));
+      mix((uint64_t)(uint32_t)child->min_width |
+          ((uint64_t)(uint32_t)child->min_height << 32));
+      mix((uint64_t)(uint32_t)child->max_width |
+          ((uint64_t)(uint32_t)child->max_height << 32));
+    }
+    return h;
+  }
+
+  /// @brief Whether the last computed layout is still valid for the current
+  /// inputs. Call store_layout_fingerprint() at the end of a recompute (after
+  /// update_responsive has settled child visibility/constraints) so the
+  /// stored hash reflects the state the geometry was derived from.
+  bool layout_up_to_date() const {
+    return layout_cache_valid_ &&
+           compute_layout_fingerprint() == layout_fingerprint_;
+  }
+
+  /// @brief Record the inputs the just-finished layout was computed from
+  void store_layout_fingerprint() {
+    layout_fingerprint_ = compute_layout_fingerprint();
+    layout_cache_valid_ = true;
+  }
+
+  /// @brief Recurse into child containers without touching own geometry;
+  /// used on the skip path so independently invalidated subtrees still
+  /// relayout
+  void layout_descendants() {
+    for (auto &child : children_) {
+      if (!child || !child->visible) continue;
+      if (auto cont = std::dynamic_pointer_cast<Container>(child)) {
+        cont->layout();
+      }
+    }
+  }
+
   int last_propagated_child_height = 0;
   int last_propagated_child_width = 0;
   bool fixed_height_is_propagated = false;
@@ -6665,11 +8766,24 @@ class Vertical : public Container {
   void layout() override {
     if (children_.empty()) return;
 
-    // Update responsive state for all children
+    // Propagate responsive state and auto_shrink constraints first:
+    // update_responsive folds nested fixed_* changes into the child
+    // fields the fingerprint hashes, so the skip check must run on
+    // post-propagation values or a grandchild constraint change would
+    // never invalidate the cached geometry
     for (auto &child : children_) {
       child->update_responsive();
     }
 
+    // Incremental layout: when nothing this layout depends on changed,
+    // keep the cached geometry (skipping the flex distribution and
+    // geometry writes) and only recurse so invalidated nested
+    // containers still get their pass
+    if (layout_up_to_date()) {
+      layout_descendants();
+      return;
+    }
+
     // Distribute height among children with min/max clamping
     std::vector<int> sizes;
     distribute_flex(children_, height, true, sizes);
@@ -6702,6 +8816,8 @@ class Vertical : public Container {
         cont->layout();
       }
     }
+
+    store_layout_fingerprint();
   }
 
  protected:
@@ -6717,11 +8833,17 @@ class Horizontal : public Container {
   void layout() override {
     if (children_.empty()) return;
 
-    // Update responsive state for all children
+    // Constraint propagation before the skip check, as in Vertical
     for (auto &child : children_) {
       child->update_responsive();
     }
 
+    // Incremental layout: same skip-and-recurse shortcut as Vertical
+    if (layout_up_to_date()) {
+      layout_descendants();
+      return;
+    }
+
     // Distribute width among children with min/max clamping
     std::vector<int> sizes;
     distribute_flex(children_, width, false, sizes);
@@ -6748,6 +8870,8 @@ class Horizontal : public Container {
         cont->layout();
       }
     }
+
+    store_layout_fingerprint();
   }
 
  protected:
@@ -7597,7 +9721,7 @@ class ToggleSwitch : public Widget {
       int byte_len;
       if (utf8_decode_codepoint(full_text, pos, codepoint, byte_len)) {
         CharInfo ci;
-        ci.content = full_text.substr(pos, byte_len);
+        ci.content = std::string_view(full_text).substr(pos, byte_len);
         ci.display_width = char_display_width(codepoint);
         if (ci.display_width < 0) ci.display_width = 0;
         chars.push_back(ci);
@@ -8290,10 +10414,14 @@ class TreeView : public ScrollableVertical {
   }
 
   void layout() override {
-    if (children_.empty()) return;
+    // Materialize row widgets for the viewport slice of the flattened index
+    if (viewport_dirty_ || scroll_offset != viewport_start_) {
+      rebuild_viewport();
+    }
 
-    // 1. Calculate Content Dimensions
-    content_height = 0;
+    // 1. Content height comes straight from the index; width is measured
+    // over the materialized viewport rows only
+    content_height = (int)visible_nodes_.size();
     int max_content_width = 0;
 
     for (auto &child : children_) {
@@ -8306,9 +10434,6 @@ class TreeView : public ScrollableVertical {
         int w = (int)btn->get_label().size() + 2;  // + padding
         if (w > max_content_width) max_content_width = w;
       }
-
-      int intended_height = (child->fixed_height > 0) ? child->fixed_height : 1;
-      content_height += intended_height;
     }
 
     // 2. Determine Scrollbars
@@ -8327,8 +10452,10 @@ class TreeView : public ScrollableVertical {
       effective_width = width - 1;
     }
 
-    // 3. Layout Children
-    int current_y = y - scroll_offset;
+    // 3. Layout Children. children_ holds only rows
+    // [viewport_start_, viewport_start_ + children_.size()), so they stack
+    // from our own top edge with no scroll translation.
+    int current_y = y;
     int final_child_width = std::max(effective_width, max_content_width);
 
     // Clamp scroll_x_
@@ -8360,12 +10487,11 @@ class TreeView : public ScrollableVertical {
 
     // layout calculated dimensions, let's re-derive for rendering props
     // Ideally we should cache these in layout, but re-calc is cheap enough for
-    // now
-    content_height = 0;
+    // now (only viewport rows are materialized)
+    content_height = (int)visible_nodes_.size();
     int max_content_width = 0;
     for (auto &child : children_) {
       if (child->visible) {
-        content_height += (child->fixed_height > 0 ? child->fixed_height : 1);
         if (auto btn = std::dynamic_pointer_cast<Button>(child)) {
           int w = (int)btn->get_label().size() + 2;
           if (w > max_content_width) max_content_width = w;
@@ -8411,29 +10537,101 @@ class TreeView : public ScrollableVertical {
     buffer.pop_clip();
   }
 
+  /// @brief Rebuild the flattened visible-row index from scratch.
+  /// Cost is proportional to the number of visible rows (collapsed subtrees
+  /// are skipped entirely); row widgets are only materialized for the
+  /// viewport slice, so huge trees stay cheap to refresh.
   void refresh() {
-    children_.clear();
+    children_.clear();  // Row widgets hold node pointers; drop them eagerly
     visible_nodes_.clear();
-    content_height = 0;
+    visible_depths_.clear();
 
     for (auto &node : root_nodes) {
-      process_node(node, 0);
+      append_visible(node, 0);
+    }
+    content_height = (int)visible_nodes_.size();
+    viewport_dirty_ = true;
+
+    // Re-apply selection state visual if needed (handled in render/widget
+    // creation) Handle lost selection if node removed Assumes stable pointers
+    // between rebuilds
+  }
+
+  TreeNode *get_selected_node() const { return selected_node_; }
+
+  void set_selected_node(TreeNode *node) {
+    if (selected_node_) selected_node_->selected = false;
+    selected_node_ = node;
+    if (selected_node_) selected_node_->selected = true;
+    if (on_select && selected_node_) on_select(selected_node_);
+    viewport_dirty_ = true;  // Restyle viewport rows; no index rebuild needed
+    ensure_visible(node);
+  }
+
+  /// @brief Re-point the selection without dereferencing the old pointer
+  /// or firing on_select; for callers re-resolving the same logical node
+  /// after a tree mutation (append/sort) may have moved it in memory.
+  /// The node's own selected flag travels with it on move, so only the
+  /// address needs fixing up.
+  void rebind_selection(TreeNode *node) {
+    selected_node_ = node;
+    viewport_dirty_ = true;
+  }
+
+  /// @brief Number of rows currently in the flattened visible index
+  int visible_row_count() const { return (int)visible_nodes_.size(); }
+
+  /// @brief Expand a node by splicing its visible subtree into the flattened
+  /// index. O(subtree + shift), never a full-tree walk.
+  /// @param index_hint Row index of the node if the caller already knows it
+  void expand_node(TreeNode *node, int index_hint = -1) {
+    if (!node || node->expanded) return;
+    node->expanded = true;
+
+    int idx = index_at(node, index_hint);
+    if (idx < 0) {
+      refresh();  // Node not currently visible; fall back to a full rebuild
+    } else {
+      std::vector<TreeNode *> sub_nodes;
+      std::vector<int> sub_depths;
+      for (auto &child : node->children) {
+        append_subtree(child, visible_depths_[idx] + 1, sub_nodes, sub_depths);
+      }
+      visible_nodes_.insert(visible_nodes_.begin() + idx + 1, sub_nodes.begin(),
+                            sub_nodes.end());
+      visible_depths_.insert(visible_depths_.begin() + idx + 1,
+                             sub_depths.begin(), sub_depths.end());
+      content_height = (int)visible_nodes_.size();
+      viewport_dirty_ = true;
     }
 
-    // Re-apply selection state visual if needed (handled in render/widget
-    // creation) Handle lost selection if node removed Assumes stable pointers
-    // between rebuilds
+    if (on_expand) on_expand(node);
   }
 
-  TreeNode *get_selected_node() const { return selected_node_; }
+  /// @brief Collapse a node by splicing its visible subtree out of the
+  /// flattened index. O(subtree + shift), never a full-tree walk.
+  /// @param index_hint Row index of the node if the caller already knows it
+  void collapse_node(TreeNode *node, int index_hint = -1) {
+    if (!node || !node->expanded) return;
+    node->expanded = false;
 
-  void set_selected_node(TreeNode *node) {
-    if (selected_node_) selected_node_->selected = false;
-    selected_node_ = node;
-    if (selected_node_) selected_node_->selected = true;
-    if (on_select && selected_node_) on_select(selected_node_);
-    refresh();  // Rebuild to update styles
-    ensure_visible(node);
+    int idx = index_at(node, index_hint);
+    if (idx < 0) {
+      refresh();
+    } else {
+      int depth = visible_depths_[idx];
+      int end = idx + 1;
+      while (end < (int)visible_depths_.size() && visible_depths_[end] > depth)
+        ++end;
+      visible_nodes_.erase(visible_nodes_.begin() + idx + 1,
+                           visible_nodes_.begin() + end);
+      visible_depths_.erase(visible_depths_.begin() + idx + 1,
+                            visible_depths_.begin() + end);
+      content_height = (int)visible_nodes_.size();
+      viewport_dirty_ = true;
+    }
+
+    if (on_collapse) on_collapse(node);
   }
 
   bool on_event(const Event &event) override {
@@ -8469,9 +10667,7 @@ class TreeView : public ScrollableVertical {
         if (selected_node_) {
           if (!selected_node_->children.empty()) {
             if (!selected_node_->expanded) {
-              selected_node_->expanded = true;
-              if (on_expand) on_expand(selected_node_);
-              refresh();
+              expand_node(selected_node_, current_idx);
             } else {
               // Already expanded, move down to first child if exists
               // Next node in visible list is the child
@@ -8485,9 +10681,7 @@ class TreeView : public ScrollableVertical {
       } else if (event.is_nav_left()) {  // Left
         if (selected_node_) {
           if (selected_node_->expanded && !selected_node_->children.empty()) {
-            selected_node_->expanded = false;
-            if (on_collapse) on_collapse(selected_node_);
-            refresh();
+            collapse_node(selected_node_, current_idx);
           } else {
             // Move to parent
             // Find parent to traverse up
@@ -8501,12 +10695,10 @@ class TreeView : public ScrollableVertical {
         if (selected_node_) {
           // Toggle expansion if has children
           if (!selected_node_->children.empty()) {
-            selected_node_->expanded = !selected_node_->expanded;
-            if (selected_node_->expanded && on_expand)
-              on_expand(selected_node_);
-            if (!selected_node_->expanded && on_collapse)
-              on_collapse(selected_node_);
-            refresh();
+            if (selected_node_->expanded)
+              collapse_node(selected_node_, current_idx);
+            else
+              expand_node(selected_node_, current_idx);
           } else {
             if (on_submit) on_submit(selected_node_);
           }
@@ -8534,7 +10726,25 @@ class TreeView : public ScrollableVertical {
 
  private:
   TreeNode *selected_node_ = nullptr;
+  // Flattened index of visible rows (parallel arrays). Maintained
+  // incrementally by expand_node()/collapse_node() splices; rebuilt wholesale
+  // only by refresh().
   std::vector<TreeNode *> visible_nodes_;
+  std::vector<int> visible_depths_;
+  bool viewport_dirty_ = true;
+  int viewport_start_ = 0;
+
+  /// @brief Find a node's row in the flattened index, trusting a caller hint
+  int index_at(TreeNode *node, int hint) const {
+    if (hint >= 0 && hint < (int)visible_nodes_.size() &&
+        visible_nodes_[hint] == node) {
+      return hint;
+    }
+    for (size_t i = 0; i < visible_nodes_.size(); ++i) {
+      if (visible_nodes_[i] == node) return (int)i;
+    }
+    return -1;
+  }
 
   TreeNode *find_parent(TreeNode *child, std::vector<TreeNode> &nodes) {
     for (auto &n : nodes) {
@@ -8552,14 +10762,7 @@ class TreeView : public ScrollableVertical {
   }
 
   void ensure_visible(TreeNode *node) {
-    // Calculate index
-    int idx = -1;
-    for (size_t i = 0; i < visible_nodes_.size(); ++i) {
-      if (visible_nodes_[i] == node) {
-        idx = i;
-        break;
-      }
-    }
+    int idx = index_at(node, -1);
     if (idx == -1) return;
 
     // Each item height is 1
@@ -8619,9 +10822,48 @@ class TreeView : public ScrollableVertical {
     return false;
   }
 
-  void process_node(TreeNode &node, int depth) {
+  void append_visible(TreeNode &node, int depth) {
     visible_nodes_.push_back(&node);
+    visible_depths_.push_back(depth);
+
+    if (node.expanded) {
+      for (auto &child : node.children) {
+        append_visible(child, depth + 1);
+      }
+    }
+  }
+
+  static void append_subtree(TreeNode &node, int depth,
+                             std::vector<TreeNode *> &nodes,
+                             std::vector<int> &depths) {
+    nodes.push_back(&node);
+    depths.push_back(depth);
+
+    if (node.expanded) {
+      for (auto &child : node.children) {
+        append_subtree(child, depth + 1, nodes, depths);
+      }
+    }
+  }
+
+  /// @brief Re-materialize row widgets for the viewport slice of the index
+  void rebuild_viewport() {
+    int total = (int)visible_nodes_.size();
+    int max_scroll = std::max(0, total - height);
+    if (scroll_offset > max_scroll) scroll_offset = max_scroll;
+    if (scroll_offset < 0) scroll_offset = 0;
+
+    children_.clear();
+    int end = std::min(total, scroll_offset + std::max(height, 0));
+    for (int i = scroll_offset; i < end; ++i) {
+      make_row_widget(*visible_nodes_[i], visible_depths_[i]);
+    }
 
+    viewport_start_ = scroll_offset;
+    viewport_dirty_ = false;
+  }
+
+  void make_row_widget(TreeNode &node, int depth) {
     std::string indent;
     for (int i = 0; i < depth; ++i) indent += indent_unit;
 
@@ -8649,8 +10891,10 @@ class TreeView : public ScrollableVertical {
     auto btn = std::make_shared<Button>(text, [this, ptr]() {
       set_selected_node(ptr);
       if (!ptr->children.empty()) {
-        ptr->expanded = !ptr->expanded;
-        refresh();
+        if (ptr->expanded)
+          collapse_node(ptr);
+        else
+          expand_node(ptr);
       } else {
         if (on_submit) on_submit(ptr);
       }
@@ -8670,49 +10914,36 @@ class TreeView : public ScrollableVertical {
           selected_bg;  // Keep selection color on hover if selected
 
     add(btn);
-
-    if (node.expanded) {
-      for (auto &child : node.children) {
-        process_node(child, depth + 1);
-      }
-    }
   }
 };
 
-/// @brief A filesystem browser widget using TreeView
+/// @brief A filesystem browser widget using TreeView.
+/// By default the whole tree is scanned synchronously in refresh(). Pass an
+/// App pointer to enable background scanning: directories are enumerated on
+/// a worker thread one level at a time (children populate on first expand),
+/// entries stream into the tree in batches via App::post, and a per-node
+/// spinner marks directories still being scanned. The UI stays responsive
+/// for the entire scan.
 class FileExplorer : public Container {
  public:
-  FileExplorer(const std::string &root_path = ".") : root_path_(root_path) {
+  FileExplorer(const std::string &root_path = ".", App *app = nullptr)
+      : root_path_(root_path), app_(app) {
     tree_view_ = std::make_shared<TreeView>();
     add(tree_view_);
     refresh();
   }
 
+  ~FileExplorer();
+
   std::function<void(std::string)> on_file_selected;
 
-  void refresh() {
-    tree_view_->root_nodes.clear();
-    tree_view_->clear_children();
-
-    std::filesystem::path p = std::filesystem::absolute(root_path_);
-    TreeNode root;
-    root.label = p.filename().string();
-    if (root.label.empty()) root.label = root_path_;
-    root.user_data = p.string();
-    root.expanded = true;
-    populate_node_recursive(root, p);
-    tree_view_->root_nodes.push_back(root);
+  /// @brief Entries delivered per App::post batch during background scans
+  int scan_batch_size = 64;
 
-    tree_view_->on_submit = [this](TreeNode *node) {
-      if (on_file_selected && node && !node->user_data.empty()) {
-        if (!std::filesystem::is_directory(node->user_data)) {
-          on_file_selected(node->user_data);
-        }
-      }
-    };
+  void refresh();
 
-    tree_view_->refresh();
-  }
+  /// @brief True while any background directory scan is in flight
+  bool is_scanning() const { return !scanning_dirs_.empty(); }
 
   void layout() override {
     if (tree_view_) {
@@ -8726,8 +10957,53 @@ class FileExplorer : public Container {
 
  private:
   std::string root_path_;
+  App *app_ = nullptr;  // Non-null enables background scanning
   std::shared_ptr<TreeView> tree_view_;
 
+  // Background scan state. The worker thread and posted callbacks hold the
+  // shared state so the widget can be destroyed mid-scan: the destructor
+  // flips cancelled and late callbacks become no-ops.
+  struct ScanState {
+    std::atomic<bool> cancelled{false};
+  };
+  std::shared_ptr<ScanState> scan_state_ = std::make_shared<ScanState>();
+  std::unordered_set<std::string> scanned_dirs_;
+  // Directories currently being scanned, mapped to their pre-scan icon
+  std::unordered_map<std::string, std::string> scanning_dirs_;
+  TimerId spinner_timer_ = {-1};
+  size_t spinner_frame_ = 0;
+
+  void start_scan(const std::string &dir_path);
+  void apply_scan_batch(const std::string &dir_path,
+                        std::vector<TreeNode> entries, bool done);
+  void advance_spinners();
+  void stop_spinner_timer();
+
+  TreeNode *find_node_by_path(TreeNode &node, const std::string &path) {
+    if (node.user_data == path) return &node;
+    for (auto &c : node.children) {
+      if (auto *res = find_node_by_path(c, path)) return res;
+    }
+    return nullptr;
+  }
+
+  TreeNode *find_node_by_path(const std::string &path) {
+    for (auto &root : tree_view_->root_nodes) {
+      if (auto *res = find_node_by_path(root, path)) return res;
+    }
+    return nullptr;
+  }
+
+  static void sort_entries(std::vector<TreeNode> &entries) {
+    std::sort(entries.begin(), entries.end(),
+              [](const TreeNode &a, const TreeNode &b) {
+                bool a_is_dir = a.id == "dir";
+                bool b_is_dir = b.id == "dir";
+                if (a_is_dir != b_is_dir) return a_is_dir;
+                return a.label < b.label;
+              });
+  }
+
   void populate_node_recursive(TreeNode &node,
                                const std::filesystem::path &path) {
     try {
@@ -8926,14 +11202,23 @@ class Border : public Container {
         break;
     }
 
+    // Resolved once per frame at most: the border repeats the same two
+    // colors across every edge cell and each title glyph
+    const BorderColors &style =
+        style_cache_.get({color_, bg_color_}, 0, [&] {
+          BorderColors s;
+          s.fg = color_.resolve(Theme::current().border);
+          s.bg = bg_color_.resolve(Theme::current().background);
+          s.selection_bg = Theme::current().selection;
+          s.selection_fg = Color::contrast_color(s.selection_bg);
+          return s;
+        });
+
     // Horizontal
     for (int dx = 0; dx < width; ++dx) {
-      Color fg = color_.resolve(Theme::current().border);
-      Color bg = bg_color_.resolve(Theme::current().background);
-
       Cell c;
-      c.fg_color = fg;
-      c.bg_color = bg;
+      c.fg_color = style.fg;
+      c.bg_color = style.bg;
       if (dx == 0) {
         c.content = tl;
         buffer.set(x, y, c);
@@ -8952,12 +11237,9 @@ class Border : public Container {
     }
     // Vertical (excluding corners)
     for (int dy = 1; dy < height - 1; ++dy) {
-      Color fg = color_.resolve(Theme::current().border);
-      Color bg = bg_color_.resolve(Theme::current().background);
-
       Cell c;
-      c.fg_color = fg;
-      c.bg_color = bg;
+      c.fg_color = style.fg;
+      c.bg_color = style.bg;
       c.content = v_line;
       buffer.set(x, y + dy, c);
       buffer.set(x + width - 1, y + dy, c);
@@ -8993,12 +11275,12 @@ class Border : public Container {
         if (ci.display_width > 0) {
           Cell c;
           c.content = ci.content;
-          c.fg_color = color_.resolve(Theme::current().border);
-          c.bg_color = bg_color_.resolve(Theme::current().background);
+          c.fg_color = style.fg;
+          c.bg_color = style.bg;
 
           if (selected) {
-            c.bg_color = Theme::current().selection;
-            c.fg_color = Color::contrast_color(c.bg_color);
+            c.bg_color = style.selection_bg;
+            c.fg_color = style.selection_fg;
           }
 
           buffer.set(start_x + cell_x, y, c);
@@ -9023,6 +11305,13 @@ class Border : public Container {
   std::string title_;
   Alignment title_align_ = Alignment::Center;
 
+  /// @brief Theme-resolved border and title colors
+  struct BorderColors {
+    Color fg, bg;
+    Color selection_bg, selection_fg;
+  };
+  StyleCache<BorderColors> style_cache_;
+
   SelectionState selection_state_;
 
   int get_container_padding_height() const override { return 2; }
@@ -9814,23 +12103,136 @@ class Checkbox : public Widget {
   bool checked_;
 };
 
+/// @brief Capacity-bounded ring buffer for streaming series data, shared by
+/// Sparkline, LineChart series and Heatmap rows. push() is amortized O(1)
+/// and evicts the oldest sample once the window is full. The window is kept
+/// physically contiguous (the backing vector holds up to twice the capacity
+/// and is compacted on overflow) so render paths read data()/size()
+/// directly, and the window min/max are maintained incrementally with
+/// monotonic deques instead of rescanning every frame.
+template <typename T>
+class RingSeries {
+ public:
+  explicit RingSeries(size_t capacity = 0) : capacity_(capacity) {}
+
+  /// @brief Change the window size; shrinking drops the oldest samples
+  void set_capacity(size_t capacity) {
+    capacity_ = capacity;
+    while (count_ > capacity_) evict_front();
+  }
+
+  size_t capacity() const { return capacity_; }
+  size_t size() const { return count_; }
+  bool empty() const { return count_ == 0; }
+
+  /// @brief Monotonic change counter; bumped by push/evict/clear. Lets
+  /// callers cache derived state and detect when the window has moved
+  uint64_t revision() const { return revision_; }
+
+  void clear() {
+    buf_.clear();
+    start_ = 0;
+    count_ = 0;
+    head_seq_ = next_seq_;
+    min_win_.clear();
+    max_win_.clear();
+    ++revision_;
+  }
+
+  /// @brief Append a sample, evicting the oldest once the window is full
+  void push(T v) {
+    if (capacity_ == 0) return;
+    if (count_ == capacity_) evict_front();
+    if (buf_.size() >= capacity_ * 2) {
+      // Amortized compaction keeps the window physically contiguous
+      std::copy(buf_.begin() + start_, buf_.end(), buf_.begin());
+      buf_.resize(count_);
+      start_ = 0;
+    }
+    buf_.push_back(v);
+    ++count_;
+
+    // Monotonic window deques: amortized O(1) min/max maintenance
+    while (!min_win_.empty() && min_win_.back().value >= v)
+      min_win_.pop_back();
+    min_win_.push_back({v, next_seq_});
+    while (!max_win_.empty() && max_win_.back().value <= v)
+      max_win_.pop_back();
+    max_win_.push_back({v, next_seq_});
+
+    ++next_seq_;
+    ++revision_;
+  }
+
+  /// @brief Oldest-to-newest indexing into the window
+  T operator[](size_t i) const { return buf_[start_ + i]; }
+
+  /// @brief Contiguous view of the window, oldest sample first
+  const T *data() const { return buf_.data() + start_; }
+
+  /// @brief Smallest value in the window (window must be non-empty)
+  T min() const { return min_win_.front().value; }
+  /// @brief Largest value in the window (window must be non-empty)
+  T max() const { return max_win_.front().value; }
+
+ private:
+  struct Entry {
+    T value;
+    uint64_t seq;
+  };
+
+  void evict_front() {
+    if (count_ == 0) return;
+    if (!min_win_.empty() && min_win_.front().seq == head_seq_)
+      min_win_.pop_front();
+    if (!max_win_.empty() && max_win_.front().seq == head_seq_)
+      max_win_.pop_front();
+    ++head_seq_;
+    ++start_;
+    --count_;
+    ++revision_;
+  }
+
+  size_t capacity_ = 0;
+  std::vector<T> buf_;  // Holds at most 2 * capacity_ samples
+  size_t start_ = 0;    // Offset of the oldest sample in buf_
+  size_t count_ = 0;
+  uint64_t head_seq_ = 0;  // Sequence number of the oldest sample
+  uint64_t next_seq_ = 0;  // Sequence number of the next pushed sample
+  std::deque<Entry> min_win_;
+  std::deque<Entry> max_win_;
+  uint64_t revision_ = 0;
+};
+
 /// @brief Displays a simple line graph of data values
 class Sparkline : public Widget {
  public:
   std::vector<float> data;
+  /// @brief Rolling window store; preferred over data when non-empty.
+  /// Feed it with push() for O(1) appends instead of erase(begin())
+  RingSeries<float> stream{256};
   Color color = {0, 255, 255, true};
 
+  /// @brief Append a sample to the rolling window
+  void push(float v) { stream.push(v); }
+
   void render(Buffer &buffer) override {
-    if (data.empty()) return;
+    const float *vals = data.data();
+    int n = (int)data.size();
+    if (!stream.empty()) {
+      vals = stream.data();
+      n = (int)stream.size();
+    }
+    if (n == 0) return;
     const std::string blocks[] = {" ", "▂", "▃", "▄", "▅", "▆", "▇", "█"};
-    int start_idx = std::max(0, (int)data.size() - width);
+    int start_idx = std::max(0, n - width);
     Color c_col = color.resolve(Theme::current().primary);
 
     for (int dx = 0; dx < width; ++dx) {
       int data_idx = start_idx + dx;
-      if (data_idx >= (int)data.size()) break;
+      if (data_idx >= n) break;
 
-      float val = data[data_idx];
+      float val = vals[data_idx];
       if (val < 0) val = 0;
       if (val > 1) val = 1;
       int level = static_cast<int>(val * 7);
@@ -9878,28 +12280,158 @@ class BrailleCanvas {
     int dx = vx % 2;
     int dy = vy % 4;
 
-    uint8_t bit = 0;
-    if (dx == 0) {
-      if (dy == 0)
-        bit = 0x01;  // 1
-      else if (dy == 1)
-        bit = 0x02;  // 2
-      else if (dy == 2)
-        bit = 0x04;  // 3
-      else if (dy == 3)
-        bit = 0x40;  // 7
-    } else {
-      if (dy == 0)
-        bit = 0x08;  // 4
-      else if (dy == 1)
-        bit = 0x10;  // 5
-      else if (dy == 2)
-        bit = 0x20;  // 6
-      else if (dy == 3)
-        bit = 0x80;  // 8
+    grid[cy * width + cx] |= kDotBits[dx & 1][dy & 3];
+  }
+
+  /// @brief OR a horizontal run of dots [vx0, vx1] on virtual row vy.
+  /// Clips once, then touches each cell exactly once, word-wide in the
+  /// interior, instead of one bounds-checked set_dot per dot
+  void draw_hline_run(int vx0, int vx1, int vy) {
+    if (vx1 < vx0) std::swap(vx0, vx1);
+    if (vy < 0 || vy >= height * 4) return;
+    if (vx0 < 0) vx0 = 0;
+    if (vx1 > width * 2 - 1) vx1 = width * 2 - 1;
+    if (vx0 > vx1) return;
+
+    int dy = vy & 3;
+    int cx0 = vx0 >> 1, cx1 = vx1 >> 1;
+    uint8_t *row = grid.data() + (vy >> 2) * width;
+
+    if (cx0 == cx1) {
+      uint8_t m = 0;
+      for (int vx = vx0; vx <= vx1; ++vx) m |= kDotBits[vx & 1][dy];
+      row[cx0] |= m;
+      return;
+    }
+
+    uint8_t left = kDotBits[0][dy];
+    uint8_t right = kDotBits[1][dy];
+    uint8_t both = left | right;
+
+    row[cx0] |= (vx0 & 1) ? right : both;
+    row[cx1] |= (vx1 & 1) ? both : left;
+    or_run(row + cx0 + 1, cx1 - cx0 - 1, both);
+  }
+
+  /// @brief OR a filled rectangle of dots (virtual coordinates, inclusive),
+  /// walking cells in row-major order with word-wide interior writes
+  void fill_rect(int vx0, int vy0, int vx1, int vy1) {
+    if (vx1 < vx0) std::swap(vx0, vx1);
+    if (vy1 < vy0) std::swap(vy0, vy1);
+    if (vx0 < 0) vx0 = 0;
+    if (vy0 < 0) vy0 = 0;
+    if (vx1 > width * 2 - 1) vx1 = width * 2 - 1;
+    if (vy1 > height * 4 - 1) vy1 = height * 4 - 1;
+    if (vx0 > vx1 || vy0 > vy1) return;
+
+    int cx0 = vx0 >> 1, cx1 = vx1 >> 1;
+    int cy0 = vy0 >> 2, cy1 = vy1 >> 2;
+
+    for (int cy = cy0; cy <= cy1; ++cy) {
+      int dy0 = (cy == cy0) ? (vy0 & 3) : 0;
+      int dy1 = (cy == cy1) ? (vy1 & 3) : 3;
+      uint8_t left = column_mask(0, dy0, dy1);
+      uint8_t right = column_mask(1, dy0, dy1);
+      uint8_t *row = grid.data() + cy * width;
+
+      if (cx0 == cx1) {
+        uint8_t m = 0;
+        for (int dx = vx0 & 1; dx <= (((cx0 * 2 + 1) <= vx1) ? 1 : 0); ++dx)
+          m |= column_mask(dx, dy0, dy1);
+        row[cx0] |= m;
+        continue;
+      }
+
+      row[cx0] |= (vx0 & 1) ? right : (uint8_t)(left | right);
+      row[cx1] |= (vx1 & 1) ? (uint8_t)(left | right) : left;
+      or_run(row + cx0 + 1, cx1 - cx0 - 1, (uint8_t)(left | right));
+    }
+  }
+
+  /// @brief Draw a line segment between virtual coordinates (Bresenham),
+  /// accumulating dot bits locally so each touched cell is OR'd once
+  void draw_line(int vx0, int vy0, int vx1, int vy1) {
+    // Axis-aligned segments take the run-based fast paths
+    if (vy0 == vy1) {
+      draw_hline_run(vx0, vx1, vy0);
+      return;
+    }
+    if (vx0 == vx1) {
+      fill_rect(vx0, vy0, vx1, vy1);
+      return;
+    }
+
+    int dx = std::abs(vx1 - vx0), sx = vx0 < vx1 ? 1 : -1;
+    int dy = -std::abs(vy1 - vy0), sy = vy0 < vy1 ? 1 : -1;
+    int err = dx + dy;
+
+    int cur_cx = -1, cur_cy = -1;
+    uint8_t pending = 0;
+    auto flush = [&]() {
+      if (pending && cur_cx >= 0 && cur_cx < width && cur_cy >= 0 &&
+          cur_cy < height) {
+        grid[cur_cy * width + cur_cx] |= pending;
+      }
+      pending = 0;
+    };
+
+    int px = vx0, py = vy0;
+    while (true) {
+      int cx = px >= 0 ? px >> 1 : -1;
+      int cy = py >= 0 ? py >> 2 : -1;
+      if (cx != cur_cx || cy != cur_cy) {
+        flush();
+        cur_cx = cx;
+        cur_cy = cy;
+      }
+      if (px >= 0 && py >= 0) pending |= kDotBits[px & 1][py & 3];
+      if (px == vx1 && py == vy1) break;
+      int e2 = 2 * err;
+      if (e2 >= dy) {
+        err += dy;
+        px += sx;
+      }
+      if (e2 <= dx) {
+        err += dx;
+        py += sy;
+      }
     }
+    flush();
+  }
 
-    grid[cy * width + cx] |= bit;
+  /// @brief Plot a connected polyline through virtual-coordinate points
+  void draw_polyline(const std::vector<std::pair<int, int>> &points) {
+    if (points.empty()) return;
+    if (points.size() == 1) {
+      set_dot(points[0].first, points[0].second);
+      return;
+    }
+    for (size_t i = 1; i < points.size(); ++i) {
+      draw_line(points[i - 1].first, points[i - 1].second, points[i].first,
+                points[i].second);
+    }
+  }
+
+  /// @brief Emit every non-empty cell into a Buffer in one row-major pass,
+  /// building the braille UTF-8 bytes in place (no per-cell get_char string)
+  void blit_to(Buffer &buffer, int dest_x, int dest_y, const Color &fg,
+               const Color &bg) const {
+    char utf8[3];
+    utf8[0] = (char)0xE2;
+    for (int cy = 0; cy < height; ++cy) {
+      const uint8_t *row = grid.data() + cy * width;
+      for (int cx = 0; cx < width; ++cx) {
+        uint8_t mask = row[cx];
+        if (!mask) continue;
+        utf8[1] = (char)(0xA0 | ((mask >> 6) & 0x03));
+        utf8[2] = (char)(0x80 | (mask & 0x3F));
+        Cell c;
+        c.content = std::string_view(utf8, 3);
+        c.fg_color = fg;
+        c.bg_color = bg;
+        buffer.set(dest_x + cx, dest_y + cy, c);
+      }
+    }
   }
 
   // Unicode Braille Pattern Start: U+2800
@@ -9926,6 +12458,34 @@ class BrailleCanvas {
     s[2] = (char)(0x80 | (mask & 0x3F));
     return s;
   }
+
+ private:
+  // Dot bit for virtual offsets within a cell, indexed [dx][dy]
+  static constexpr uint8_t kDotBits[2][4] = {
+      {0x01, 0x02, 0x04, 0x40},
+      {0x08, 0x10, 0x20, 0x80},
+  };
+
+  /// @brief Mask covering dots dy0..dy1 (inclusive) in one cell column
+  static uint8_t column_mask(int dx, int dy0, int dy1) {
+    uint8_t m = 0;
+    for (int dy = dy0; dy <= dy1; ++dy) m |= kDotBits[dx][dy];
+    return m;
+  }
+
+  /// @brief OR a mask into a run of cells, eight at a time
+  static void or_run(uint8_t *p, int count, uint8_t mask) {
+    uint64_t word = 0x0101010101010101ULL * mask;
+    while (count >= 8) {
+      uint64_t w;
+      std::memcpy(&w, p, 8);
+      w |= word;
+      std::memcpy(p, &w, 8);
+      p += 8;
+      count -= 8;
+    }
+    while (count-- > 0) *p++ |= mask;
+  }
 };
 
 /// @brief Base class for chart widgets with shared axis and tooltip
@@ -9958,6 +12518,9 @@ class Tooltip : public Widget {
 
   void attach(std::shared_ptr<Widget> w) { target = w; }
 
+  /// @brief Tooltips render at screen-absolute coordinates
+  bool renders_outside_bounds() const override { return true; }
+
   void show() { visible_ = true; }
   void hide() { visible_ = false; }
 
@@ -10114,7 +12677,7 @@ class Tooltip : public Widget {
         bool selected = selection_state_.is_selected(char_idx);
 
         Cell c;
-        c.content = text.substr(pos, byte_len);
+        c.content = std::string_view(text).substr(pos, byte_len);
         c.fg_color = selected ? sel_fg : fg;
         c.bg_color = selected ? sel_bg : bg;
 
@@ -10188,6 +12751,11 @@ class ChartBase : public Widget {
   bool show_legend = false;
   std::chrono::steady_clock::time_point last_hit_time_;
 
+  // Decimation: series with many more samples than plot columns are reduced
+  // to per-column min/max pairs before plotting, so spikes survive and frame
+  // cost stays proportional to the plot width instead of the data size
+  bool decimate_large_series = true;
+
  protected:
   /// @brief Format a tick label value
   std::string format_tick_label(double val, bool is_x_axis) const {
@@ -10199,6 +12767,110 @@ class ChartBase : public Widget {
     ss << std::fixed << val;
     return ss.str();
   }
+
+  /// @brief Incrementally maintained min/max pyramid over a value series.
+  /// Level k folds 2^(k+1) consecutive samples into one {min, max} bucket,
+  /// so an append touches O(log n) buckets and any index range decomposes
+  /// into O(log n) aligned buckets for an exact range min/max
+  struct MinMaxPyramid {
+    struct Bucket {
+      double min = 0.0, max = 0.0;
+      int min_idx = 0, max_idx = 0;
+    };
+
+    std::vector<std::vector<Bucket>> levels;
+    size_t size = 0;
+
+    void clear() {
+      levels.clear();
+      size = 0;
+    }
+
+    void append(double v) {
+      int idx = (int)size++;
+      for (size_t k = 0; k == 0 || levels[k - 1].size() > 1; ++k) {
+        if (levels.size() <= k) levels.emplace_back();
+        auto &lvl = levels[k];
+        size_t bucket = (size_t)idx >> (k + 1);
+        if (bucket >= lvl.size()) {
+          if (k == 0) {
+            lvl.push_back({v, v, idx, idx});
+          } else {
+            // Seed from the already-folded child buckets one level down.
+            // A freshly created level's bucket 0 spans samples that were
+            // appended before the level existed; seeding with only the
+            // current value would silently drop their extrema.
+            Bucket b = levels[k - 1][bucket * 2];
+            if (bucket * 2 + 1 < levels[k - 1].size()) {
+              const Bucket &sib = levels[k - 1][bucket * 2 + 1];
+              if (sib.min < b.min) {
+                b.min = sib.min;
+                b.min_idx = sib.min_idx;
+              }
+              if (sib.max > b.max) {
+                b.max = sib.max;
+                b.max_idx = sib.max_idx;
+              }
+            }
+            lvl.push_back(b);
+          }
+        } else {
+          Bucket &b = lvl[bucket];
+          if (v < b.min) {
+            b.min = v;
+            b.min_idx = idx;
+          }
+          if (v > b.max) {
+            b.max = v;
+            b.max_idx = idx;
+          }
+        }
+      }
+    }
+
+    /// @brief Exact min/max over [lo, hi) using the largest aligned buckets;
+    /// unaligned edge samples fall back to the raw data
+    Bucket query(const double *data, int lo, int hi) const {
+      Bucket out{data[lo], data[lo], lo, lo};
+      int i = lo;
+      while (i < hi) {
+        int picked = -1;
+        for (int k = (int)levels.size() - 1; k >= 0; --k) {
+          int span = 1 << (k + 1);
+          if (i % span != 0) continue;
+          // A partially filled trailing bucket is only usable when the
+          // queried range also ends at the series end
+          if (i + span <= hi || (hi == (int)size && i + span >= hi)) {
+            picked = k;
+            break;
+          }
+        }
+        if (picked >= 0) {
+          const Bucket &b = levels[picked][(size_t)i >> (picked + 1)];
+          if (b.min < out.min) {
+            out.min = b.min;
+            out.min_idx = b.min_idx;
+          }
+          if (b.max > out.max) {
+            out.max = b.max;
+            out.max_idx = b.max_idx;
+          }
+          i += 1 << (picked + 1);
+        } else {
+          if (data[i] < out.min) {
+            out.min = data[i];
+            out.min_idx = i;
+          }
+          if (data[i] > out.max) {
+            out.max = data[i];
+            out.max_idx = i;
+          }
+          ++i;
+        }
+      }
+      return out;
+    }
+  };
 };
 
 /// @brief A multi-series line chart
@@ -10214,6 +12886,9 @@ class LineChart : public ChartBase {
   /// @brief Data series definition
   struct Series {
     std::vector<double> data;  ///< Data points
+    /// @brief Rolling window store; takes precedence over data when
+    /// non-empty. Feed with stream.push() for O(1) windowed appends
+    RingSeries<double> stream;
     std::string label;         ///< Series label for legend
     Color color;               ///< Drawing color
     std::string marker = "*";  ///< Marker character (for Points style)
@@ -10509,8 +13184,10 @@ class LineChart : public ChartBase {
 
       // Get the max data size for X range
       size_t max_data_size = 0;
-      for (const auto &s : series)
-        if (s.data.size() > max_data_size) max_data_size = s.data.size();
+      for (const auto &s : series) {
+        size_t sz = s.stream.empty() ? s.data.size() : s.stream.size();
+        if (sz > max_data_size) max_data_size = sz;
+      }
       double x_min_val = 0;
       double x_max_val = (double)(max_data_size > 0 ? max_data_size - 1 : 0);
 
@@ -10575,13 +13252,20 @@ class LineChart : public ChartBase {
     draw_height = plot_height;
     if (draw_height <= 0 || draw_width <= 0) return;
 
+    if (decimate_large_series) sync_pyramids();
+
     [[maybe_unused]] bool needs_braille = false;
     for (const auto &s : series)
       if (s.style == LineStyle::Braille) needs_braille = true;
 
     for (int s_idx = 0; s_idx < (int)series.size(); ++s_idx) {
       const auto &s = series[s_idx];
-      if (s.data.empty()) continue;
+      // Ring-buffered streams take precedence over the plain data vector;
+      // both expose a contiguous window
+      bool use_stream = !s.stream.empty();
+      const double *vals = use_stream ? s.stream.data() : s.data.data();
+      int n = use_stream ? (int)s.stream.size() : (int)s.data.size();
+      if (n == 0) continue;
 
       LineStyle effective_style = s.style;
       if (effective_style == LineStyle::Braille && !Terminal::has_utf8()) {
@@ -10602,120 +13286,197 @@ class LineChart : public ChartBase {
           return (virtual_h - 1) - row_from_bottom;
         };
 
-        int prev_vy = -1;
+        int total_vx = draw_width * 2;
+        bool decimated = decimate_large_series && n > total_vx * 2;
+
+        if (decimated) {
+          // Min/max decimation: each virtual column draws its exact value
+          // envelope from the pyramid, so spikes survive and cost is
+          // O(columns) regardless of series length
+          const MinMaxPyramid &pyr = pyramids_[s_idx];
+          int prev_top = -1, prev_bot = -1;
+
+          for (int vx = 0; vx < total_vx; ++vx) {
+            int lo = (int)((long long)vx * n / total_vx);
+            int hi = (int)((long long)(vx + 1) * n / total_vx);
+            if (hi <= lo) hi = lo + 1;
+            auto b = pyr.query(vals, lo, hi);
+
+            int vy_top = map_y(b.max);
+            int vy_bot = map_y(b.min);
+            bc.fill_rect(vx, vy_top, vx, vy_bot);
+
+            // Bridge to the previous column's envelope
+            if (s.fill_gaps && prev_top != -1) {
+              if (vy_top > prev_bot) {
+                bc.fill_rect(vx, prev_bot + 1, vx, vy_top - 1);
+              } else if (vy_bot < prev_top) {
+                bc.fill_rect(vx, vy_bot + 1, vx, prev_top - 1);
+              }
+            }
+            prev_top = vy_top;
+            prev_bot = vy_bot;
 
-        for (int dx = 0; dx < draw_width; ++dx) {
-          for (int sub_x = 0; sub_x < 2; ++sub_x) {
-            double ratio = 0.0;
-            if (draw_width > 0) {
-              double vx = dx * 2 + sub_x;
-              double total_vx = draw_width * 2;
-              if (total_vx > 1) ratio = vx / (total_vx - 1);
+            // Tooltips hit-test against the decimated extremes only
+            if (show_tooltip && (vx & 1) == 0) {
+              point_hits_.push_back({draw_x + vx / 2, draw_y + vy_top / 4,
+                                     s_idx, b.max_idx, b.max});
             }
+          }
+        } else {
+          int prev_vy = -1;
+
+          for (int dx = 0; dx < draw_width; ++dx) {
+            for (int sub_x = 0; sub_x < 2; ++sub_x) {
+              double ratio = 0.0;
+              if (draw_width > 0) {
+                double vx = dx * 2 + sub_x;
+                if (total_vx > 1) ratio = vx / (total_vx - 1);
+              }
 
-            double exact_idx = ratio * (s.data.size() - 1);
+              double exact_idx = ratio * (n - 1);
 
-            // Linear Interpolation
-            int idx0 = (int)exact_idx;
-            int idx1 = idx0 + 1;
-            if (idx1 >= (int)s.data.size()) idx1 = (int)s.data.size() - 1;
+              // Linear Interpolation
+              int idx0 = (int)exact_idx;
+              int idx1 = idx0 + 1;
+              if (idx1 >= n) idx1 = n - 1;
 
-            double frac = exact_idx - idx0;
-            double val = s.data[idx0] * (1.0 - frac) + s.data[idx1] * frac;
+              double frac = exact_idx - idx0;
+              double val = vals[idx0] * (1.0 - frac) + vals[idx1] * frac;
 
-            int vy = map_y(val);
+              int vy = map_y(val);
 
-            // Connect dots (Interpolate Y)
-            if (prev_vy != -1 && s.fill_gaps) {
-              int start_y = std::min(prev_vy, vy);
-              int end_y = std::max(prev_vy, vy);
-              for (int y = start_y; y <= end_y; ++y) {
-                bc.set_dot(dx * 2 + sub_x, y);
+              // Connect dots (Interpolate Y)
+              if (prev_vy != -1 && s.fill_gaps) {
+                int start_y = std::min(prev_vy, vy);
+                int end_y = std::max(prev_vy, vy);
+                for (int y = start_y; y <= end_y; ++y) {
+                  bc.set_dot(dx * 2 + sub_x, y);
+                }
+              } else {
+                bc.set_dot(dx * 2 + sub_x, vy);
               }
-            } else {
-              bc.set_dot(dx * 2 + sub_x, vy);
-            }
-            prev_vy = vy;
-
-            // Record Hit (approximate for Braille: map back to cell)
-            // Use the main cell center logic
-            if (sub_x == 0) {  // Record once per column for simplicity
-              int cell_y = vy / 4;
-              if (show_tooltip) {
-                point_hits_.push_back(
-                    {draw_x + dx, draw_y + cell_y, s_idx, idx0, s.data[idx0]});
+              prev_vy = vy;
+
+              // Record Hit (approximate for Braille: map back to cell)
+              // Use the main cell center logic
+              if (sub_x == 0) {  // Record once per column for simplicity
+                int cell_y = vy / 4;
+                if (show_tooltip) {
+                  point_hits_.push_back(
+                      {draw_x + dx, draw_y + cell_y, s_idx, idx0, vals[idx0]});
+                }
               }
             }
           }
         }
 
         // Blit BrailleCanvas to Buffer
-        for (int by = 0; by < draw_height; ++by) {
-          for (int bx = 0; bx < draw_width; ++bx) {
-            std::string bchar = bc.get_char(bx, by);
-            if (!bchar.empty()) {
-              Cell c;
-              c.content = bchar;
-              c.fg_color = s.color;
-              c.bg_color = bg;
-              buffer.set(draw_x + bx, draw_y + by, c);
-            }
-          }
-        }
+        bc.blit_to(buffer, draw_x, draw_y, s.color, bg);
       } else if (effective_style == LineStyle::Lines) {
-        int prev_screen_y = -1;
-
-        for (int dx = 0; dx < draw_width; ++dx) {
-          int data_idx = 0;
-          if (draw_width > 1) {
-            double ratio = (double)dx / (draw_width - 1);
-            data_idx = (int)(ratio * (s.data.size() - 1));
-          }
-          if (data_idx >= (int)s.data.size()) data_idx = (int)s.data.size() - 1;
+        bool decimated = decimate_large_series && n > draw_width * 2;
 
-          double val = s.data[data_idx];
-          double norm = (val - min_val) / (max_val - min_val);
+        auto to_row = [&](double v) -> int {
+          double norm = (v - min_val) / (max_val - min_val);
           if (norm < 0) norm = 0;
           if (norm > 1) norm = 1;
-
           int row_from_bottom = (int)(norm * (draw_height - 1));
-          int screen_y = (y + draw_height - 1) - row_from_bottom;
+          return (y + draw_height - 1) - row_from_bottom;
+        };
 
-          // Plot
-          Cell c;
-          c.content = s.marker;
-          c.fg_color = s.color;
-          c.bg_color = bg;
-          buffer.set(draw_x + dx, screen_y, c);
+        if (decimated) {
+          // Min/max decimation: draw each column's exact value envelope so
+          // spikes survive, in O(columns) regardless of series length
+          const MinMaxPyramid &pyr = pyramids_[s_idx];
+          int prev_top = -1, prev_bot = -1;
 
-          // Record Hit
-          if (show_tooltip) {
-            point_hits_.push_back(
-                {draw_x + dx, screen_y, s_idx, data_idx, val});
+          for (int dx = 0; dx < draw_width; ++dx) {
+            int lo = (int)((long long)dx * n / draw_width);
+            int hi = (int)((long long)(dx + 1) * n / draw_width);
+            if (hi <= lo) hi = lo + 1;
+            auto b = pyr.query(vals, lo, hi);
+
+            int top = to_row(b.max);  // Max value sits on the upper row
+            int bot = to_row(b.min);
+
+            Cell c;
+            c.content = s.marker;
+            c.fg_color = s.color;
+            c.bg_color = bg;
+            for (int iy = top; iy <= bot; ++iy) buffer.set(draw_x + dx, iy, c);
+
+            // Bridge to the previous column's envelope
+            if (s.fill_gaps && prev_top != -1) {
+              if (top > prev_bot) {
+                for (int iy = prev_bot + 1; iy < top; ++iy)
+                  buffer.set(draw_x + dx, iy, c);
+              } else if (bot < prev_top) {
+                for (int iy = bot + 1; iy < prev_top; ++iy)
+                  buffer.set(draw_x + dx, iy, c);
+              }
+            }
+            prev_top = top;
+            prev_bot = bot;
+
+            // Tooltips hit-test against the decimated extremes only
+            if (show_tooltip) {
+              point_hits_.push_back({draw_x + dx, top, s_idx, b.max_idx, b.max});
+              if (bot != top) {
+                point_hits_.push_back(
+                    {draw_x + dx, bot, s_idx, b.min_idx, b.min});
+              }
+            }
           }
+        } else {
+          int prev_screen_y = -1;
+
+          for (int dx = 0; dx < draw_width; ++dx) {
+            int data_idx = 0;
+            if (draw_width > 1) {
+              double ratio = (double)dx / (draw_width - 1);
+              data_idx = (int)(ratio * (n - 1));
+            }
+            if (data_idx >= n) data_idx = n - 1;
+
+            double val = vals[data_idx];
+            int screen_y = to_row(val);
 
-          // Fill Gap
-          if (s.style == LineStyle::Lines && s.fill_gaps &&
-              prev_screen_y != -1) {
-            int dir = (screen_y > prev_screen_y) ? 1 : -1;
-            int count = std::abs(screen_y - prev_screen_y);
-            for (int k = 1; k < count; ++k) {
-              buffer.set(draw_x + dx, prev_screen_y + k * dir,
-                         c);  // Vertical fill only
+            // Plot
+            Cell c;
+            c.content = s.marker;
+            c.fg_color = s.color;
+            c.bg_color = bg;
+            buffer.set(draw_x + dx, screen_y, c);
+
+            // Record Hit
+            if (show_tooltip) {
+              point_hits_.push_back(
+                  {draw_x + dx, screen_y, s_idx, data_idx, val});
             }
-            // Improved vertical fill:
-            int y1 = prev_screen_y;
-            int y2 = screen_y;
-            if (dx > 0) {  // Connect to previous column
-              // Fill vertical column at current X to bridge the jump
-              int lower = std::min(y1, y2);
-              int upper = std::max(y1, y2);
-              for (int iy = lower + 1; iy < upper; ++iy) {
-                buffer.set(draw_x + dx, iy, c);
+
+            // Fill Gap
+            if (s.style == LineStyle::Lines && s.fill_gaps &&
+                prev_screen_y != -1) {
+              int dir = (screen_y > prev_screen_y) ? 1 : -1;
+              int count = std::abs(screen_y - prev_screen_y);
+              for (int k = 1; k < count; ++k) {
+                buffer.set(draw_x + dx, prev_screen_y + k * dir,
+                           c);  // Vertical fill only
+              }
+              // Improved vertical fill:
+              int y1 = prev_screen_y;
+              int y2 = screen_y;
+              if (dx > 0) {  // Connect to previous column
+                // Fill vertical column at current X to bridge the jump
+                int lower = std::min(y1, y2);
+                int upper = std::max(y1, y2);
+                for (int iy = lower + 1; iy < upper; ++iy) {
+                  buffer.set(draw_x + dx, iy, c);
+                }
               }
             }
+            prev_screen_y = screen_y;
           }
-          prev_screen_y = screen_y;
         }
       }
     }
@@ -10742,6 +13503,37 @@ class LineChart : public ChartBase {
 
     // 5. Render Tooltip
   }
+
+  /// @brief Drop cached decimation state. Appends to series data are picked
+  /// up automatically; call this after editing existing samples in place
+  void invalidate_decimation() { pyramids_.clear(); }
+
+ private:
+  // Per-series min/max pyramids, grown incrementally as data is appended
+  mutable std::vector<MinMaxPyramid> pyramids_;
+  mutable std::vector<uint64_t> stream_revisions_;
+
+  void sync_pyramids() const {
+    pyramids_.resize(series.size());
+    stream_revisions_.resize(series.size(), 0);
+    for (size_t i = 0; i < series.size(); ++i) {
+      auto &pyr = pyramids_[i];
+      if (!series[i].stream.empty()) {
+        // Rolling window: the slide invalidates the whole pyramid, so
+        // rebuild only when the window actually moved
+        const auto &stream = series[i].stream;
+        if (stream_revisions_[i] != stream.revision()) {
+          pyr.clear();
+          for (size_t j = 0; j < stream.size(); ++j) pyr.append(stream[j]);
+          stream_revisions_[i] = stream.revision();
+        }
+        continue;
+      }
+      const auto &data = series[i].data;
+      if (pyr.size > data.size()) pyr.clear();  // Series shrank: rebuild
+      for (size_t j = pyr.size; j < data.size(); ++j) pyr.append(data[j]);
+    }
+  }
 };
 
 /// @brief A scatter plot chart
@@ -11051,7 +13843,15 @@ class ScatterChart : public ChartBase {
     draw_height = plot_height;
     if (draw_height <= 0 || draw_width <= 0) return;
 
+    if (decimate_large_series) sync_decimation(draw_width);
+
     for (const auto &s : series) {
+      int s_index = (int)(&s - &series[0]);
+      // Dense series plot only the cached per-column min/max points
+      bool decimated = decimate_large_series &&
+                       s_index < (int)decimated_.size() &&
+                       !decimated_[s_index].empty();
+
       bool use_braille = s.use_braille;
       if (use_braille && !Terminal::has_utf8()) {
         use_braille = false;
@@ -11080,11 +13880,11 @@ class ScatterChart : public ChartBase {
           return (int)(norm * (virtual_w - 1));
         };
 
-        for (int i = 0; i < (int)s.points.size(); ++i) {
+        auto plot_point = [&](int i) {
           const auto &p = s.points[i];
           double px = p.first;
           double py = p.second;
-          if (px < x_min || px > x_max || py < y_min || py > y_max) continue;
+          if (px < x_min || px > x_max || py < y_min || py > y_max) return;
 
           int vx = map_x(px);
           int vy = map_y(py);
@@ -11094,37 +13894,35 @@ class ScatterChart : public ChartBase {
           if (show_tooltip && draw_width > 0 && draw_height > 0) {
             int hit_x = draw_x + vx / 2;
             int hit_y = draw_y + vy / 4;
-            point_hits_.push_back(
-                {hit_x, hit_y, (int)(&s - &series[0]), i, px, py});
+            point_hits_.push_back({hit_x, hit_y, s_index, i, px, py});
           }
-        }
+        };
 
-        // Blit BrailleCanvas to Buffer
-        for (int by = 0; by < draw_height; ++by) {
-          for (int bx = 0; bx < draw_width; ++bx) {
-            std::string bchar = bc.get_char(bx, by);
-            if (!bchar.empty()) {
-              Cell c;
-              c.content = bchar;
-              c.fg_color = s.color;
-              c.bg_color = bg;
-              buffer.set(draw_x + bx, draw_y + by, c);
-            }
+        if (decimated) {
+          for (const auto &ce : decimated_[s_index]) {
+            if (ce.min_idx == -1) continue;
+            plot_point(ce.max_idx);
+            if (ce.min_idx != ce.max_idx) plot_point(ce.min_idx);
           }
+        } else {
+          for (int i = 0; i < (int)s.points.size(); ++i) plot_point(i);
         }
+
+        // Blit BrailleCanvas to Buffer
+        bc.blit_to(buffer, draw_x, draw_y, s.color, bg);
       } else {
-        for (int i = 0; i < (int)s.points.size(); ++i) {
+        auto plot_point = [&](int i) {
           const auto &p = s.points[i];
           double px = p.first;
           double py = p.second;
 
           // Map X
           double norm_x = (px - x_min) / (x_max - x_min);
-          if (norm_x < 0 || norm_x > 1) continue;
+          if (norm_x < 0 || norm_x > 1) return;
 
           // Map Y
           double norm_y = (py - y_min) / (y_max - y_min);
-          if (norm_y < 0 || norm_y > 1) continue;
+          if (norm_y < 0 || norm_y > 1) return;
 
           int screen_x = (int)(norm_x * (draw_width - 1));
           int row_from_bottom = (int)(norm_y * (draw_height - 1));
@@ -11138,9 +13936,19 @@ class ScatterChart : public ChartBase {
 
           // Record Hit
           if (show_tooltip) {
-            point_hits_.push_back({draw_x + screen_x, draw_y + screen_y,
-                                   (int)(&s - &series[0]), i, px, py});
+            point_hits_.push_back(
+                {draw_x + screen_x, draw_y + screen_y, s_index, i, px, py});
+          }
+        };
+
+        if (decimated) {
+          for (const auto &ce : decimated_[s_index]) {
+            if (ce.min_idx == -1) continue;
+            plot_point(ce.max_idx);
+            if (ce.min_idx != ce.max_idx) plot_point(ce.min_idx);
           }
+        } else {
+          for (int i = 0; i < (int)s.points.size(); ++i) plot_point(i);
         }
       }
     }
@@ -11160,12 +13968,112 @@ class ScatterChart : public ChartBase {
           c.fg_color = s.color;
           buffer.set(lx + i, ly, c);
         }
-        ly++;
-        if (ly >= y + height) break;
+        ly++;
+        if (ly >= y + height) break;
+      }
+    }
+
+    // 5. Render Tooltip
+  }
+
+  /// @brief Drop the cached decimated point set (rebuilt on next render).
+  /// Appends and view-range changes are picked up automatically; call this
+  /// after editing existing points in place
+  void invalidate_decimation() {
+    decimated_.clear();
+    decimated_sizes_.clear();
+    decimated_vcols_ = -1;
+  }
+
+ private:
+  struct ColumnExtent {
+    int min_idx = -1, max_idx = -1;
+    double min_y = 0.0, max_y = 0.0;
+  };
+
+  // Per-series, per virtual column (2 per cell, matching braille X
+  // resolution) min/max points. Cached across frames; rebuilt in one O(n)
+  // pass only when the view range or plot width changes, and extended
+  // incrementally when points are appended, so pan/zoom stays interactive
+  mutable std::vector<std::vector<ColumnExtent>> decimated_;
+  mutable std::vector<size_t> decimated_sizes_;
+  mutable int decimated_vcols_ = -1;
+  mutable double dec_x_min_ = 0.0, dec_x_max_ = 0.0;
+  mutable double dec_y_min_ = 0.0, dec_y_max_ = 0.0;
+
+  bool should_decimate(const Series &s, int draw_width) const {
+    return (int)s.points.size() > draw_width * 4;
+  }
+
+  void accumulate_points(size_t si, int from) const {
+    const auto &s = series[si];
+    auto &cols = decimated_[si];
+    decimated_sizes_[si] = s.points.size();
+    if (cols.empty()) return;
+
+    double x_span = dec_x_max_ - dec_x_min_;
+    if (x_span <= 0) return;
+
+    int vcols = (int)cols.size();
+    for (int i = from; i < (int)s.points.size(); ++i) {
+      const auto &p = s.points[i];
+      if (p.first < dec_x_min_ || p.first > dec_x_max_ ||
+          p.second < dec_y_min_ || p.second > dec_y_max_)
+        continue;
+      int vc = (int)((p.first - dec_x_min_) / x_span * (vcols - 1));
+      if (vc < 0) vc = 0;
+      if (vc >= vcols) vc = vcols - 1;
+      ColumnExtent &ce = cols[vc];
+      if (ce.min_idx == -1 || p.second < ce.min_y) {
+        ce.min_idx = i;
+        ce.min_y = p.second;
+      }
+      if (ce.max_idx == -1 || p.second > ce.max_y) {
+        ce.max_idx = i;
+        ce.max_y = p.second;
+      }
+    }
+  }
+
+  void sync_decimation(int draw_width) const {
+    int vcols = draw_width * 2;
+    bool dims_match = decimated_vcols_ == vcols && dec_x_min_ == x_min &&
+                      dec_x_max_ == x_max && dec_y_min_ == y_min &&
+                      dec_y_max_ == y_max &&
+                      decimated_.size() == series.size();
+
+    if (dims_match) {
+      // Same view: extend columns with newly appended points only
+      for (size_t si = 0; si < series.size(); ++si) {
+        size_t n = series[si].points.size();
+        if (n < decimated_sizes_[si]) {
+          dims_match = false;  // Series shrank: full rebuild
+          break;
+        }
+        if (decimated_[si].empty() && should_decimate(series[si], draw_width)) {
+          decimated_[si].assign(vcols, {});
+          accumulate_points(si, 0);
+        } else if (n > decimated_sizes_[si]) {
+          accumulate_points(si, (int)decimated_sizes_[si]);
+        }
       }
+      if (dims_match) return;
     }
 
-    // 5. Render Tooltip
+    decimated_.assign(series.size(), {});
+    decimated_sizes_.assign(series.size(), 0);
+    decimated_vcols_ = vcols;
+    dec_x_min_ = x_min;
+    dec_x_max_ = x_max;
+    dec_y_min_ = y_min;
+    dec_y_max_ = y_max;
+
+    for (size_t si = 0; si < series.size(); ++si) {
+      if (should_decimate(series[si], draw_width)) {
+        decimated_[si].assign(vcols, {});
+      }
+      accumulate_points(si, 0);
+    }
   }
 };
 
@@ -11783,7 +14691,7 @@ class ShortcutBar : public Widget {
         int byte_len;
         if (utf8_decode_codepoint(item.key, pos, codepoint, byte_len)) {
           Cell c;
-          c.content = item.key.substr(pos, byte_len);
+          c.content = std::string_view(item.key).substr(pos, byte_len);
           c.fg_color = k_fg;
           c.bg_color = k_bg;
           buffer.set(cx, y, c);
@@ -11815,7 +14723,7 @@ class ShortcutBar : public Widget {
         int byte_len;
         if (utf8_decode_codepoint(item.description, pos, codepoint, byte_len)) {
           Cell c;
-          c.content = item.description.substr(pos, byte_len);
+          c.content = std::string_view(item.description).substr(pos, byte_len);
           c.fg_color = d_fg;
           c.bg_color = bg;
 
@@ -12133,7 +15041,7 @@ class ProportionalBar : public Widget {
           int byte_len;
           if (utf8_decode_codepoint(lbl, pos, codepoint, byte_len)) {
             Cell c;
-            c.content = lbl.substr(pos, byte_len);
+            c.content = std::string_view(lbl).substr(pos, byte_len);
             c.fg_color = Theme::current().foreground;
             c.bg_color = bg;
             buffer.set(legend_x + 1 + cell_x, legend_y, c);
@@ -12413,7 +15321,7 @@ class Breadcrumb : public Widget {
           int byte_len;
           if (utf8_decode_codepoint(separator, sep_pos, codepoint, byte_len)) {
             Cell c;
-            c.content = separator.substr(sep_pos, byte_len);
+            c.content = std::string_view(separator).substr(sep_pos, byte_len);
             c.fg_color = sep;
             c.bg_color = bg;
             buffer.set(cx, y, c);
@@ -12460,7 +15368,7 @@ class Breadcrumb : public Widget {
       // Find which item was clicked
       int cx = x;
       for (size_t i = 0; i < items.size(); ++i) {
-        int item_end = cx + utf8_display_width(items[i].label);
+        int item_end = cx + utf8_display_width(items[i].label.plain_text());
         if (event.x >= cx && event.x < item_end) {
           hover_index = i;
           selected_index = i;
@@ -12482,21 +15390,63 @@ class Breadcrumb : public Widget {
 class Heatmap : public Widget {
  public:
   std::vector<std::vector<double>> data;  // 2D data grid, values 0-1
+  /// @brief Rolling row stores; take precedence over data when non-empty.
+  /// Feed each row with streams[r].push() for O(1) windowed appends
+  std::vector<RingSeries<double>> streams;
   std::vector<StyledText> row_labels;
   std::vector<StyledText> col_labels;
   bool show_values = false;
+  /// @brief Render two data rows per terminal row as ▀ (fg = top row,
+  /// bg = bottom row), doubling vertical density; show_values is ignored
+  /// since there is no room for text inside a half cell
+  bool half_block = false;
 
   Color low_color = Color(0, 0, 128);
   Color high_color = Color(255, 0, 0);
 
-  void set_data(const std::vector<std::vector<double>> &d) { data = d; }
+  void set_data(const std::vector<std::vector<double>> &d) {
+    data = d;
+    flat_data_.clear();
+    flat_rows_ = 0;
+    flat_cols_ = 0;
+  }
+
+  /// @brief Bulk-load a flat row-major grid without nested-vector copies;
+  /// takes precedence over data when non-empty
+  void set_data(const std::vector<double> &values, int rows, int cols) {
+    flat_data_.assign(values.begin(), values.end());
+    flat_data_.resize((size_t)std::max(0, rows) * std::max(0, cols), 0.0);
+    flat_rows_ = std::max(0, rows);
+    flat_cols_ = std::max(0, cols);
+  }
+
+  /// @brief Update one cell of the flat grid in place
+  void set_cell(int r, int c, double v) {
+    if (r < 0 || r >= flat_rows_ || c < 0 || c >= flat_cols_) return;
+    flat_data_[(size_t)r * flat_cols_ + c] = v;
+  }
 
   void render(Buffer &buffer) override {
     Color bg = bg_color.resolve(Theme::current().background);
 
-    if (data.empty()) return;
-    int rows = data.size();
-    int cols = data[0].size();
+    bool use_flat = flat_rows_ > 0 && flat_cols_ > 0;
+    bool use_streams = !use_flat && !streams.empty();
+    if (!use_flat && !use_streams && data.empty()) return;
+    int rows = use_flat        ? flat_rows_
+               : use_streams   ? (int)streams.size()
+                               : (int)data.size();
+    int cols = 0;
+    if (use_flat) {
+      cols = flat_cols_;
+    } else if (use_streams) {
+      for (const auto &s : streams) cols = std::max(cols, (int)s.size());
+    } else {
+      cols = (int)data[0].size();
+    }
+    if (cols == 0) return;
+
+    rebuild_gradient_if_needed();
+    refresh_row_caches(use_flat, use_streams, rows, cols);
 
     int label_width = 0;
     for (const auto &lbl : row_labels) {
@@ -12505,13 +15455,16 @@ class Heatmap : public Widget {
     }
     label_width = std::min(label_width + 1, 10);
 
+    bool halves = half_block && !show_values;
+    int band_rows = halves ? (rows + 1) / 2 : rows;
     int cell_w = std::max(1, (width - label_width) / std::max(1, cols));
-    int cell_h = std::max(1, (height - 1) / std::max(1, rows));
+    int cell_h = std::max(1, (height - 1) / std::max(1, band_rows));
 
-    for (int r = 0; r < rows && y + r * cell_h < y + height; ++r) {
-      // Row label - UTF-8 safe
-      if (r < (int)row_labels.size()) {
-        StyledText styled_lbl = row_labels[r];
+    for (int r = 0; r < band_rows && y + r * cell_h < y + height; ++r) {
+      int top_row = halves ? r * 2 : r;
+      // Row label - UTF-8 safe (in half-block mode, the band's top row)
+      if (top_row < (int)row_labels.size()) {
+        StyledText styled_lbl = row_labels[top_row];
         auto text_chars =
             TextHelper::prepare_text_for_render(styled_lbl.plain_text());
         int cell_x = 0;
@@ -12544,30 +15497,30 @@ class Heatmap : public Widget {
         }
       }
 
+      const std::vector<Color> &top = row_color_cache_[top_row];
+      const std::vector<Color> *bottom =
+          halves && top_row + 1 < rows ? &row_color_cache_[top_row + 1]
+                                       : nullptr;
+
       for (int c_idx = 0;
            c_idx < cols && x + label_width + c_idx * cell_w < x + width;
            ++c_idx) {
-        double val = data[r][c_idx];
-        if (val < 0) val = 0;
-        if (val > 1) val = 1;
-
-        // Interpolate color
-        uint8_t cr =
-            (uint8_t)(low_color.r + val * (high_color.r - low_color.r));
-        uint8_t cg =
-            (uint8_t)(low_color.g + val * (high_color.g - low_color.g));
-        uint8_t cb =
-            (uint8_t)(low_color.b + val * (high_color.b - low_color.b));
-        Color cell_color(cr, cg, cb);
-
         for (int cy = 0; cy < cell_h; ++cy) {
           for (int cx = 0; cx < cell_w; ++cx) {
             Cell cell;
-            cell.content = show_values && cy == 0 && cx == 0
-                               ? std::to_string((int)(val * 100)).substr(0, 2)
-                               : " ";
-            cell.bg_color = cell_color;
-            cell.fg_color = Color::White();
+            if (halves) {
+              cell.content = "▀";
+              cell.fg_color = top[c_idx];
+              cell.bg_color = bottom ? (*bottom)[c_idx] : bg;
+            } else {
+              double val = row_value_cache_[top_row][c_idx];
+              cell.content =
+                  show_values && cy == 0 && cx == 0
+                      ? std::to_string((int)(val * 100)).substr(0, 2)
+                      : " ";
+              cell.bg_color = top[c_idx];
+              cell.fg_color = Color::White();
+            }
             buffer.set(x + label_width + c_idx * cell_w + cx,
                        y + r * cell_h + cy, cell);
           }
@@ -12575,6 +15528,91 @@ class Heatmap : public Widget {
       }
     }
   }
+
+ private:
+  static constexpr int kGradientSteps = 256;
+
+  /// @brief Rebuild the low→high lookup table only when the endpoint
+  /// colors or the theme change, instead of interpolating per cell
+  void rebuild_gradient_if_needed() {
+    uint64_t theme_gen = Theme::generation();
+    if (lut_valid_ && low_color == lut_low_ && high_color == lut_high_ &&
+        theme_gen == lut_theme_gen_) {
+      return;
+    }
+    for (int i = 0; i < kGradientSteps; ++i) {
+      double t = i / (double)(kGradientSteps - 1);
+      lut_[i] =
+          Color((uint8_t)(low_color.r + t * (high_color.r - low_color.r)),
+                (uint8_t)(low_color.g + t * (high_color.g - low_color.g)),
+                (uint8_t)(low_color.b + t * (high_color.b - low_color.b)));
+    }
+    lut_low_ = low_color;
+    lut_high_ = high_color;
+    lut_theme_gen_ = theme_gen;
+    lut_valid_ = true;
+    ++lut_gen_;
+  }
+
+  const Color &gradient_color(double val) const {
+    if (val < 0) val = 0;
+    if (val > 1) val = 1;
+    return lut_[(int)(val * (kGradientSteps - 1) + 0.5)];
+  }
+
+  /// @brief Re-resolve colors only for rows whose values changed since
+  /// the last frame. The data fields are public and mutated directly, so
+  /// dirtiness is detected by comparing values against the previous
+  /// snapshot — still far cheaper than re-interpolating every cell, and
+  /// unchanged rows then diff away in the terminal's row digests.
+  void refresh_row_caches(bool use_flat, bool use_streams, int rows,
+                          int cols) {
+    if ((int)row_value_cache_.size() != rows || cache_cols_ != cols ||
+        cache_lut_gen_ != lut_gen_) {
+      row_value_cache_.assign(rows, {});
+      row_color_cache_.assign(rows, {});
+      cache_cols_ = cols;
+      cache_lut_gen_ = lut_gen_;
+    }
+    row_scratch_.resize(cols);
+    for (int r = 0; r < rows; ++r) {
+      for (int c = 0; c < cols; ++c) {
+        double val = 0.0;
+        if (use_flat) {
+          val = flat_data_[(size_t)r * cols + c];
+        } else if (use_streams) {
+          if (c < (int)streams[r].size()) val = streams[r][c];
+        } else if (c < (int)data[r].size()) {
+          val = data[r][c];
+        }
+        row_scratch_[c] = val;
+      }
+      if (row_value_cache_[r] == row_scratch_) continue;  // Clean row
+      row_value_cache_[r] = row_scratch_;
+      auto &colors = row_color_cache_[r];
+      colors.resize(cols);
+      for (int c = 0; c < cols; ++c) {
+        colors[c] = gradient_color(row_scratch_[c]);
+      }
+    }
+  }
+
+  std::vector<double> flat_data_;  ///< Row-major; preferred over data
+  int flat_rows_ = 0;
+  int flat_cols_ = 0;
+
+  Color lut_[kGradientSteps];
+  Color lut_low_;
+  Color lut_high_;
+  uint64_t lut_theme_gen_ = 0;
+  uint64_t lut_gen_ = 0;
+  bool lut_valid_ = false;
+
+  std::vector<std::vector<double>> row_value_cache_;
+  std::vector<std::vector<Color>> row_color_cache_;
+  std::vector<double> row_scratch_;
+  int cache_cols_ = 0;
+  uint64_t cache_lut_gen_ = 0;
 };
 
 /// @brief Resizable split pane container
@@ -12670,8 +15708,10 @@ class SplitPane : public Container {
 
     Color div = divider_color.resolve(Theme::current().border);
 
-    if (pane1) pane1->render(buffer);
-    if (pane2) pane2->render(buffer);
+    if (!render_children_parallel(buffer, {pane1, pane2})) {
+      if (pane1) pane1->render(buffer);
+      if (pane2) pane2->render(buffer);
+    }
 
     // Draw divider - use pane dimensions which are already clamped by min_size
     if (!vertical) {
@@ -13109,6 +16149,9 @@ class Notification : public Widget {
   int max_visible = 3;
   Position position = Position::TopRight;
 
+  /// @brief Notifications render at screen-absolute coordinates
+  bool renders_outside_bounds() const override { return true; }
+
   // Selection and Interaction Support
   std::vector<Rect> toast_bounds;
   SelectionState selection_state_;
@@ -13843,7 +16886,7 @@ class Tabs : public Container {
     // Layout visible tab buttons
     for (size_t i = 0; i < tab_buttons_.size(); ++i) {
       auto &btn = tab_buttons_[i];
-      int btn_w = utf8_display_width(tab_names[i]) + 2;  // " " + name + " "
+      int btn_w = utf8_display_width(tab_names[i].plain_text()) + 2;  // " " + name + " "
 
       if ((int)i < visible_start) {
         btn->visible = false;
@@ -14586,6 +17629,25 @@ class TableScrollable : public Widget {
 
   int hovered_row = -1;
 
+  // Virtual data mode: when both providers are set, rows are pulled from a
+  // user-supplied backing store instead of the widget-owned `rows` vector,
+  // so memory and startup cost are O(viewport) rather than O(dataset).
+  std::function<int()> row_count_provider;  ///< Total row count callback
+  std::function<std::optional<std::vector<StyledText>>(int)>
+      row_provider;  ///< Fetch one row; std::nullopt renders the placeholder
+  std::function<void(int, int)>
+      on_viewport_change;  ///< Visible range [first, last) changed; lets the
+                           ///< provider prefetch asynchronously and call
+                           ///< App::post/update when rows arrive
+  StyledText placeholder_text = StyledText("...");  ///< Pending-row text
+  Color placeholder_fg = Color();  ///< Pending-row color (default: border)
+
+  /// @brief Number of rows, from the provider when in virtual mode
+  int row_count() const {
+    if (row_count_provider) return row_count_provider();
+    return (int)rows.size();
+  }
+
   // Helper to add a row of strings
   void add_row(const std::vector<std::string> &row) {
     std::vector<StyledText> styled_row;
@@ -14613,6 +17675,13 @@ class TableScrollable : public Widget {
 
   TableScrollable() { focusable = true; }
 
+ private:
+  // Last viewport reported through on_viewport_change
+  int last_notified_first_ = -1;
+  int last_notified_last_ = -1;
+
+ public:
+
   void scroll_to_selection() {
     if (selected_index < scroll_offset) {
       scroll_offset = selected_index;
@@ -14626,7 +17695,7 @@ class TableScrollable : public Widget {
       // SCROLLBAR HANDLING FIRST - before any other mouse processing
       int sb_x = x + width - 1;
       int visible_rows = height - 1;
-      bool scrollbar_visible = ((int)rows.size() > visible_rows);
+      bool scrollbar_visible = (row_count() > visible_rows);
 
       // Check if in scrollbar zone (rightmost 3 columns)
       bool in_scrollbar_zone = (event.x >= sb_x - 2 && event.x <= sb_x &&
@@ -14656,9 +17725,9 @@ class TableScrollable : public Widget {
           if (ratio < 0) ratio = 0;
           if (ratio > 1) ratio = 1;
 
-          int target_row = (int)(ratio * ((int)rows.size() - 1));
+          int target_row = (int)(ratio * (row_count() - 1));
           if (target_row < 0) target_row = 0;
-          if (target_row >= (int)rows.size()) target_row = (int)rows.size() - 1;
+          if (target_row >= row_count()) target_row = row_count() - 1;
 
           selected_index = target_row;
           scroll_to_selection();
@@ -14684,7 +17753,7 @@ class TableScrollable : public Widget {
               return true;
             }
           } else if (event.mouse_wheel_down()) {  // Wheel Down
-            if (selected_index < (int)rows.size() - 1) {
+            if (selected_index < row_count() - 1) {
               selected_index++;
               scroll_to_selection();
               if (on_change) on_change(selected_index);
@@ -14704,7 +17773,7 @@ class TableScrollable : public Widget {
 
           if (event.mouse_move() || event.mouse_motion()) {
             // Hover
-            if (clicked_index >= 0 && clicked_index < (int)rows.size()) {
+            if (clicked_index >= 0 && clicked_index < row_count()) {
               hovered_row = clicked_index;
             } else {
               hovered_row = -1;
@@ -14713,7 +17782,7 @@ class TableScrollable : public Widget {
           }
 
           if (event.mouse_left()) {
-            if (clicked_index >= 0 && clicked_index < (int)rows.size()) {
+            if (clicked_index >= 0 && clicked_index < row_count()) {
               selected_index = clicked_index;
               if (on_change) on_change(selected_index);
               if (event.click_count >= 2 && on_submit)
@@ -14740,7 +17809,7 @@ class TableScrollable : public Widget {
           changed = true;
         }
       } else if (event.is_nav_down()) {  // Down
-        if (selected_index < (int)rows.size() - 1) {
+        if (selected_index < row_count() - 1) {
           selected_index++;
           changed = true;
         }
@@ -14749,13 +17818,13 @@ class TableScrollable : public Widget {
         changed = true;
       } else if (event.is_view_scroll_down()) {  // PageDown
         selected_index =
-            std::min((int)rows.size() - 1, selected_index + (height - 2));
+            std::min(row_count() - 1, selected_index + (height - 2));
         changed = true;
       } else if (event.is_nav_home()) {  // Home
         selected_index = 0;
         changed = true;
       } else if (event.is_nav_end()) {  // End
-        selected_index = (int)rows.size() - 1;
+        selected_index = row_count() - 1;
         changed = true;
       } else if (event.is_enter()) {
         if (on_submit) on_submit(selected_index);
@@ -14850,17 +17919,43 @@ class TableScrollable : public Widget {
 
     // Rows
     int visible_rows = height - 1;
-    int end_row = std::min((int)rows.size(), scroll_offset + visible_rows);
+    int end_row = std::min(row_count(), scroll_offset + visible_rows);
+
+    // Notify the provider when the visible window moves so it can prefetch
+    // upcoming rows asynchronously
+    if (on_viewport_change && (scroll_offset != last_notified_first_ ||
+                               end_row != last_notified_last_)) {
+      last_notified_first_ = scroll_offset;
+      last_notified_last_ = end_row;
+      on_viewport_change(scroll_offset, end_row);
+    }
 
     Color sel_bg = selected_bg_color.resolve(Theme::current().selection);
     Color sel_fg = selected_fg_color.resolve(Theme::current().background);
     Color row_fg = row_fg_color.resolve(Theme::current().foreground);
+    Color pending_fg = placeholder_fg.resolve(Theme::current().border);
 
     for (int r = scroll_offset; r < end_row; ++r) {
       if (draw_y >= y + height) break;
 
       bool is_sel = (r == selected_index);
-      const auto &row_data = rows[r];
+
+      // Pull the row: from the provider in virtual mode (std::nullopt means
+      // the fetch is still in flight and the placeholder style is used),
+      // otherwise from the widget-owned rows
+      std::vector<StyledText> provided_row;
+      const std::vector<StyledText> *row_data_ptr = nullptr;
+      bool pending = false;
+      if (row_provider) {
+        if (auto fetched = row_provider(r)) {
+          provided_row = std::move(*fetched);
+          row_data_ptr = &provided_row;
+        } else {
+          pending = true;
+        }
+      } else if (r < (int)rows.size()) {
+        row_data_ptr = &rows[r];
+      }
 
       // Alternating row colors
       Color row_bg = (r % 2 == 0) ? Theme::current().background
@@ -14870,12 +17965,15 @@ class TableScrollable : public Widget {
       for (size_t i = 0; i < columns.size(); ++i) {
         int cw = (i < current_widths.size()) ? current_widths[i] : 10;
         StyledText styled_cell =
-            (i < row_data.size()) ? row_data[i] : StyledText("");
+            pending ? (i == 0 ? placeholder_text : StyledText(""))
+                    : ((row_data_ptr && i < row_data_ptr->size())
+                           ? (*row_data_ptr)[i]
+                           : StyledText(""));
 
         Color cell_bg =
             is_sel ? sel_bg
                    : (r == hovered_row ? Theme::current().hover : row_bg);
-        Color cell_fg = is_sel ? sel_fg : row_fg;
+        Color cell_fg = pending ? pending_fg : (is_sel ? sel_fg : row_fg);
 
         // Fill with spaces first
         for (int k = 0; k < cw; ++k) {
@@ -14923,19 +18021,171 @@ class TableScrollable : public Widget {
 
     // Draw Scrollbar (Overlay)
     int visible_h = height - 1;
-    if ((int)rows.size() > visible_h && visible_h > 0) {
+    if (row_count() > visible_h && visible_h > 0) {
       render_scrollbar(buffer, x + width - 1, y + 1, visible_h, scroll_offset,
-                       (int)rows.size(), true, scrollbar_track_color,
+                       row_count(), true, scrollbar_track_color,
                        scrollbar_thumb_color, scrollbar_track_char,
                        scrollbar_thumb_char);
     }
   }
 };
 
+/// @brief Live overlay for the frame profiler. Shows total-frame percentiles
+/// over the record ring, the last frame's per-phase breakdown, diff volume,
+/// and the most expensive widgets. App renders it topmost (like Tooltip) and
+/// re-damages its bounds each frame; toggle it with
+/// App::set_profiler_overlay().
+class ProfilerHUD : public Widget {
+ public:
+  int top_widget_count = 3;  ///< How many per-widget cost rows to show
+
+  Rect last_bounds;
+
+  /// @brief The HUD renders at screen-absolute coordinates
+  bool renders_outside_bounds() const override { return true; }
+
+  void render(Buffer &buffer) override {
+    if (!visible || !g_frame_profiler.enabled) return;
+
+    buffer.push_full_clip();
+
+    const auto &rec = g_frame_profiler.last();
+
+    std::vector<std::string> lines;
+    lines.push_back(fmt("frame %6.2fms %s", rec.total_ms,
+                        rec.partial ? "partial" : "full"));
+    lines.push_back(fmt("p50 %5.2f p95 %5.2f max %5.2f",
+                        g_frame_profiler.percentile_ms(50.0),
+                        g_frame_profiler.percentile_ms(95.0),
+                        g_frame_profiler.percentile_ms(100.0)));
+    for (int ph = 0; ph < (int)FrameProfiler::Phase::kCount; ++ph) {
+      lines.push_back(
+          fmt("%-7s %8.3fms",
+              FrameProfiler::phase_name((FrameProfiler::Phase)ph),
+              rec.phase_ms[ph]));
+    }
+    lines.push_back(
+        fmt("cells %-6d bytes %zu", rec.cells_diffed, rec.bytes_written));
+
+    // Costliest widgets this frame (the root subtree has finished rendering
+    // by the time the HUD draws)
+    auto costs = g_frame_profiler.widget_costs();
+    std::sort(costs.begin(), costs.end(),
+              [](const FrameProfiler::WidgetCost &a,
+                 const FrameProfiler::WidgetCost &b) { return a.ms > b.ms; });
+    for (int i = 0; i < top_widget_count && i < (int)costs.size(); ++i) {
+      lines.push_back(fmt("%-14s %7.3fms",
+                          pretty_type_name(costs[i].type_name).c_str(),
+                          costs[i].ms));
+    }
+
+    int panel_w = 2;
+    for (const auto &l : lines)
+      panel_w = std::max(panel_w, utf8_display_width(l) + 2);
+    int panel_h = (int)lines.size() + 2;
+
+    // Pin to the top-right corner
+    int px = buffer.width() - panel_w;
+    int py = 0;
+    if (px < 0) px = 0;
+
+    last_bounds = {px, py, panel_w, panel_h};
+    x = px;
+    y = py;
+    width = panel_w;
+    height = panel_h;
+
+    Color fg = Theme::current().foreground;
+    Color bg = Theme::current().panel_bg;
+    Color border = Theme::current().border;
+
+    for (int j = 0; j < panel_h; ++j) {
+      for (int i = 0; i < panel_w; ++i) {
+        Cell c;
+        if (j == 0 && i == 0)
+          c.content = "┌";
+        else if (j == 0 && i == panel_w - 1)
+          c.content = "┐";
+        else if (j == panel_h - 1 && i == 0)
+          c.content = "└";
+        else if (j == panel_h - 1 && i == panel_w - 1)
+          c.content = "┘";
+        else if (j == 0 || j == panel_h - 1)
+          c.content = "─";
+        else if (i == 0 || i == panel_w - 1)
+          c.content = "│";
+        else
+          c.content = " ";
+        c.fg_color = border;
+        c.bg_color = bg;
+        buffer.set(px + i, py + j, c);
+      }
+    }
+
+    for (size_t li = 0; li < lines.size(); ++li) {
+      const std::string &line = lines[li];
+      for (size_t i = 0; i < line.size() && (int)i < panel_w - 2; ++i) {
+        Cell c;
+        c.content = std::string_view(line).substr(i, 1);
+        c.fg_color = fg;
+        c.bg_color = bg;
+        buffer.set(px + 1 + (int)i, py + 1 + (int)li, c);
+      }
+    }
+
+    buffer.pop_clip();
+  }
+
+ private:
+  static std::string fmt(const char *format, ...) {
+    char buf[96];
+    va_list args;
+    va_start(args, format);
+    std::vsnprintf(buf, sizeof(buf), format, args);
+    va_end(args);
+    return buf;
+  }
+
+  /// @brief Pull the class name out of an Itanium-mangled typeid name
+  /// (e.g. "N6cpptui5LabelE" -> "Label"); unknown formats pass through
+  static std::string pretty_type_name(const char *mangled) {
+    std::string s = mangled;
+    std::string last;
+    size_t i = 0;
+    while (i < s.size()) {
+      if (s[i] >= '0' && s[i] <= '9') {
+        size_t j = i;
+        int len = 0;
+        while (j < s.size() && s[j] >= '0' && s[j] <= '9') {
+          len = len * 10 + (s[j] - '0');
+          ++j;
+        }
+        if (len > 0 && j + len <= s.size()) {
+          last = s.substr(j, len);
+          i = j + len;
+          continue;
+        }
+      }
+      ++i;
+    }
+    return last.empty() ? s : last;
+  }
+};
+
 /// @brief Main application class managing the event loop and terminal
 class App {
  public:
   App() : current_buffer_(0, 0), previous_buffer_(0, 0) {}
+
+  ~App() {
+    // Free any callbacks posted but never drained
+    PostNode *node = post_head_.exchange(nullptr);
+    while (node) {
+      PostNode *next = node->next;
+      delete node;
+      node = next;
+    }
+  }
   // Resize Debounce State
   int pending_resize_w = 0;
   int pending_resize_h = 0;
@@ -15000,6 +18250,56 @@ class App {
     active_notification_ = notif;
   }
 
+  /// @brief Show or hide the frame profiler overlay. Showing it also enables
+  /// profiling; hiding it stops instrumentation (the record ring is kept so
+  /// dump_json() still works afterwards).
+  /// @param show Whether the overlay (and profiling) should be active
+  void set_profiler_overlay(bool show) {
+    if (show && !profiler_hud_) profiler_hud_ = std::make_shared<ProfilerHUD>();
+    if (profiler_hud_) profiler_hud_->visible = show;
+    g_frame_profiler.enabled = show;
+    Widget::mark_all_dirty();
+  }
+
+  /// @brief Flip the profiler overlay (handy behind register_key)
+  void toggle_profiler_overlay() {
+    set_profiler_overlay(!g_frame_profiler.enabled);
+  }
+
+  /// @brief Choose the color mode applied to the terminal when run()
+  /// starts. Without a call the backend keeps its own default: the real
+  /// tty autodetects from the environment (see
+  /// Terminal::detect_color_mode), headless backends stay truecolor.
+  /// @param mode The SGR color encoding to render with
+  void set_color_mode(ColorMode mode) { color_mode_override_ = mode; }
+
+  /// @brief Force DEC 2026 synchronized-update framing on or off when
+  /// run() starts (autodetected for the real tty otherwise)
+  /// @param enabled Whether frames are wrapped in update guards
+  void set_synchronized_output(bool enabled) {
+    sync_output_override_ = enabled;
+  }
+
+  /// @brief Present frames through the terminal's background writer from
+  /// run() on, so a congested link never stalls the event loop. While a
+  /// frame is in flight the loop keeps handling input but defers
+  /// rendering; the skipped updates coalesce into the next frame (see
+  /// Terminal::set_async_output).
+  /// @param enabled Whether to present frames asynchronously
+  void set_async_output(bool enabled) { async_output_override_ = enabled; }
+
+  /// @brief Enable or disable parallel subtree rendering. Containers whose
+  /// visible children occupy disjoint regions (split panes, grids) render
+  /// each child on the render pool and composite the results; trees where
+  /// paint order is observable keep the serial path automatically (see
+  /// Container::render_children_parallel). Off by default.
+  /// @param enabled Whether containers may render children concurrently
+  void set_parallel_render(bool enabled) { g_parallel_render = enabled; }
+
+  /// @brief The last frame presented to the terminal. With a
+  /// HeadlessTerminal this is how tests inspect what ended up on screen.
+  const Buffer &screen_buffer() const { return previous_buffer_; }
+
   /// @brief Open a dialog at a specific screen position
   /// @param d The dialog to open
   /// @param x X coordinate (screen absolute)
@@ -15041,29 +18341,36 @@ class App {
   }
 
   /// @brief Add a recurring timer
-  /// @param interval_ms Interval in milliseconds
+  /// @param interval_ms Interval in milliseconds; clamped to >= 1 so a
+  /// zero (or negative) interval cannot pin the firing loop, which
+  /// reschedules by advancing the previous deadline
   /// @param callback Function to call
   /// @return Token identifier for the timer
   TimerId add_timer(int interval_ms, std::function<void()> callback) {
     Timer t;
     t.id = next_timer_id_++;
-    t.interval = std::chrono::milliseconds(interval_ms);
+    t.interval = std::chrono::milliseconds(std::max(1, interval_ms));
     t.callback = callback;
-    t.last_fire = std::chrono::steady_clock::now();
-    timers_.push_back(t);
-    return {t.id};
+    t.next_fire = std::chrono::steady_clock::now() + t.interval;
+    timer_heap_.push({t.next_fire, t.id});
+    timers_.emplace(t.id, std::move(t));
+    return {next_timer_id_ - 1};
   }
 
-  /// @brief Remove a timer by ID
+  /// @brief Remove a timer by ID. Safe to call from inside a timer
+  /// callback (including the timer's own); the slot is reaped lazily when
+  /// its heap entry surfaces.
   void remove_timer(TimerId id) {
-    for (auto it = timers_.begin(); it != timers_.end(); ++it) {
-      if (it->id == id.id) {
-        timers_.erase(it);
-        return;
-      }
-    }
+    auto it = timers_.find(id.id);
+    if (it != timers_.end()) it->second.active = false;
   }
 
+  /// @brief Set the timer coalescing window. Timers falling due within
+  /// @p ms of the earliest deadline fire on the same wakeup and share one
+  /// render, trading up to @p ms of per-timer accuracy for fewer frames.
+  /// Default 0 (every deadline gets its own wakeup).
+  void set_timer_coalesce_ms(int ms) { timer_coalesce_ms_ = ms > 0 ? ms : 0; }
+
   /// @brief Wake the event loop and trigger a redraw on the next iteration.
   /// Thread-safe. Can be called from any thread.
   void update() {
@@ -15080,14 +18387,25 @@ class App {
   }
 
   /// @brief Schedule a callback to run on the main UI thread, then redraw.
-  /// Thread-safe. Use this to safely modify widgets from background threads.
+  /// Thread-safe and lock-free. Use this to safely modify widgets from
+  /// background threads.
   /// @param callback Function to execute on the UI thread
   void post(std::function<void()> callback) {
-    {
-      std::lock_guard<std::mutex> lock(post_mutex_);
-      posted_callbacks_.push_back(std::move(callback));
-    }
-    update();
+    auto *node = new PostNode;
+    node->batch.push_back(std::move(callback));
+    if (push_post_node(node)) update();
+  }
+
+  /// @brief Batched post(): hand over a whole burst of updates with one
+  /// enqueue and one wakeup. The burst runs in submission order on the UI
+  /// thread and shares a single render with everything else drained that
+  /// frame. Thread-safe and lock-free.
+  /// @param callbacks Functions to execute on the UI thread
+  void post_many(std::vector<std::function<void()>> callbacks) {
+    if (callbacks.empty()) return;
+    auto *node = new PostNode;
+    node->batch = std::move(callbacks);
+    if (push_post_node(node)) update();
   }
 
   static void update_screen_size(int w, int h = 0) {
@@ -15114,12 +18432,25 @@ class App {
 
   void run(std::shared_ptr<Widget> root) {
     Terminal term;
+    run(root, term);
+  }
+
+  /// @brief Run the event loop against a caller-supplied backend. Pass a
+  /// HeadlessTerminal to render offscreen (CI, benchmarks, replaying a
+  /// recorded session); the default overload constructs the real tty backend.
+  /// @param root The root widget tree
+  /// @param term The terminal backend to read events from and present to
+  void run(std::shared_ptr<Widget> root, Terminal &term) {
     term.drainInputBuffer();  // Clear stale events from initialization
+    if (color_mode_override_) term.set_color_mode(*color_mode_override_);
+    if (sync_output_override_)
+      term.set_synchronized_output(*sync_output_override_);
+    if (async_output_override_) term.set_async_output(*async_output_override_);
     bool running = true;
     quit_app = [&]() { running = false; };
     bool needs_render = true;
 
-    auto size = term.getSize();
+    auto size = term.size();
     update_screen_size(size.first, size.second);
     current_buffer_.resize(size.first, size.second);
     previous_buffer_.resize(size.first, size.second);
@@ -15142,15 +18473,26 @@ class App {
       }
     }
 
-    // Sync all new timers to start roughly now
+    // Sync all new timers to start roughly now: re-anchor every deadline
+    // and rebuild the heap so pre-run registration time doesn't count
     auto now_start = std::chrono::steady_clock::now();
-    for (auto &t : timers_) t.last_fire = now_start;
+    timer_heap_ = {};
+    for (auto &entry : timers_) {
+      Timer &t = entry.second;
+      if (!t.active) continue;
+      t.next_fire = now_start + t.interval;
+      timer_heap_.push({t.next_fire, t.id});
+    }
 
     // Focus Stack for Dialogs
     std::vector<std::shared_ptr<Widget>> focus_stack;
     size_t last_dialog_count = 0;
 
     while (running) {
+      // A profiler frame spans one loop iteration; it is only recorded when
+      // the iteration actually renders (see end_frame below)
+      g_frame_profiler.begin_frame();
+
       // Check Dialog Stack Changes for Focus Management
       if (dialog_stack.size() != last_dialog_count) {
         if (dialog_stack.size() > last_dialog_count) {
@@ -15186,42 +18528,111 @@ class App {
           }
         }
         last_dialog_count = dialog_stack.size();
+        Widget::mark_all_dirty();
         needs_render = true;
       }
       auto now = std::chrono::steady_clock::now();
       int min_wait_ms = -1;  // Default: wait indefinitely
 
-      // 0. Drain and execute posted callbacks (from post())
+      // 0. Drain and execute posted callbacks (from post()/post_many())
       {
-        std::vector<std::function<void()>> callbacks;
-        {
-          std::lock_guard<std::mutex> lock(post_mutex_);
-          callbacks.swap(posted_callbacks_);
-        }
-        if (!callbacks.empty()) {
-          for (auto &cb : callbacks) {
-            if (cb) cb();
+        FrameProfiler::Scope prof(g_frame_profiler, FrameProfiler::Phase::Post);
+        // Take the whole stack with one exchange, then reverse it to
+        // restore submission order (producers push LIFO). The entire
+        // burst executes under this one render.
+        PostNode *taken = post_head_.exchange(nullptr,
+                                              std::memory_order_acquire);
+        if (taken) {
+          PostNode *ordered = nullptr;
+          while (taken) {
+            PostNode *next = taken->next;
+            taken->next = ordered;
+            ordered = taken;
+            taken = next;
+          }
+          while (ordered) {
+            for (auto &cb : ordered->batch) {
+              if (cb) cb();
+            }
+            PostNode *next = ordered->next;
+            delete ordered;
+            ordered = next;
           }
           needs_render = true;
         }
       }
 
       // 1. Handle Additional Timers
-      for (auto &t : timers_) {
-        auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
-            now - t.last_fire);
-        if (elapsed >= t.interval) {
+      {
+        FrameProfiler::Scope prof(g_frame_profiler,
+                                  FrameProfiler::Phase::Timers);
+        auto window = std::chrono::milliseconds(timer_coalesce_ms_);
+
+        // Fire every timer that is due, plus any falling due within the
+        // coalescing window of the first due deadline so they share this
+        // wakeup and this render. The window only ever extends a batch
+        // anchored at a due timer; nothing fires early on its own. Stale
+        // heap entries (cancelled or rescheduled timers) are discarded as
+        // they surface.
+        bool fired_any = false;
+        auto batch_end = now;
+        while (!timer_heap_.empty()) {
+          TimerDeadline top = timer_heap_.top();
+          auto it = timers_.find(top.id);
+          if (it == timers_.end()) {
+            timer_heap_.pop();
+            continue;
+          }
+          if (!it->second.active) {
+            timer_heap_.pop();
+            timers_.erase(it);  // Reap the cancelled slot
+            continue;
+          }
+          if (it->second.next_fire != top.when) {
+            timer_heap_.pop();  // Superseded by a newer deadline
+            continue;
+          }
+          if (!fired_any) {
+            if (top.when > now) break;  // Nothing due yet
+            batch_end = now + window;
+          } else if (top.when > batch_end) {
+            break;  // Beyond this wakeup's coalescing batch
+          }
+          fired_any = true;
+
+          timer_heap_.pop();
+          Timer &t = it->second;
+          // Drift-free reschedule: advance from the scheduled deadline,
+          // not from now, so animation timers don't accumulate lag. If we
+          // fell more than one interval behind, resync instead of firing a
+          // catch-up burst.
+          t.next_fire += t.interval;
+          if (t.next_fire <= now) t.next_fire = now + t.interval;
+          timer_heap_.push({t.next_fire, t.id});
           if (t.callback) {
-            t.callback();
+            t.callback();  // May add/remove timers reentrantly
             needs_render = true;
           }
-          t.last_fire = now;
-          elapsed = std::chrono::milliseconds(0);
         }
 
-        int wait = (int)(t.interval - elapsed).count();
-        if (wait < 0) wait = 0;
-        if (min_wait_ms == -1 || wait < min_wait_ms) min_wait_ms = wait;
+        // Wake exactly at the next live deadline
+        while (!timer_heap_.empty()) {
+          const TimerDeadline &top = timer_heap_.top();
+          auto it = timers_.find(top.id);
+          if (it == timers_.end() || !it->second.active ||
+              it->second.next_fire != top.when) {
+            if (it != timers_.end() && !it->second.active) timers_.erase(it);
+            timer_heap_.pop();
+            continue;
+          }
+          int wait =
+              (int)std::chrono::duration_cast<std::chrono::milliseconds>(
+                  top.when - now)
+                  .count();
+          if (wait < 0) wait = 0;
+          if (min_wait_ms == -1 || wait < min_wait_ms) min_wait_ms = wait;
+          break;
+        }
       }
 
       // 2. Check pending resize
@@ -15236,6 +18647,7 @@ class App {
           term.clearScreen();        // CLear physical screen artifacts
 
           pending_resize_w = 0;
+          Widget::mark_all_dirty();  // Resize invalidates all geometry
           needs_render = true;
         } else {
           // Need to wake up soon to finish resize
@@ -15245,56 +18657,204 @@ class App {
         }
       }
 
-      if (needs_render) {
-        if (root) {
+      // Backpressure: while the async writer still has a frame on the
+      // wire, keep handling input but defer rendering with a short poll.
+      // The deferred updates coalesce into one frame of the newest state
+      // once the link catches up; needs_render stays set.
+      bool present_busy = needs_render && term.output_pending();
+      if (present_busy && (min_wait_ms == -1 || min_wait_ms > 2)) {
+        min_wait_ms = 2;
+      }
+
+      if (needs_render && !present_busy) {
+        // Partial redraw: if the only pending changes were reported via
+        // Widget::mark_dirty(), re-render just the damaged rectangles and
+        // confine the terminal diff to them. Anything that invalidates
+        // geometry (resize, dialogs, input dispatch) forces the full path
+        // via Widget::mark_all_dirty().
+        bool partial = root && !g_full_damage && !g_damage_rects.empty();
+
+        if (partial) {
+          std::vector<Rect> damage =
+              merge_damage(g_damage_rects, current_buffer_.width(),
+                           current_buffer_.height());
+
+          // After the frame swap, current_buffer_ holds the frame before
+          // last. Re-seed only the rows the previous frame changed so it
+          // matches what is on screen before rendering new damage into it.
+          if (reseed_all_) {
+            current_buffer_ = previous_buffer_;
+          } else {
+            for (const auto &r : reseed_rects_) {
+              for (int ry = r.y; ry < r.y + r.height; ++ry) {
+                current_buffer_.copy_row_from(previous_buffer_, ry);
+              }
+            }
+          }
+
           Cell bg_cell;
           bg_cell.bg_color = Theme::current().background;
           bg_cell.fg_color = Theme::current().foreground;
-          current_buffer_.clear(bg_cell);
 
-          root->width = current_buffer_.width();
-          root->height = current_buffer_.height();
+          {
+            FrameProfiler::Scope prof(g_frame_profiler,
+                                      FrameProfiler::Phase::Render);
+            for (auto &r : damage) {
+              current_buffer_.fill_rect(r, bg_cell);
+              current_buffer_.push_clip(r);
+              // Container::render culls widgets outside the clip, so only
+              // widgets intersecting the damage actually re-render
+              root->render(current_buffer_);
+
+              for (auto &d : dialog_stack) {
+                if (d->is_open) d->render(current_buffer_);
+              }
+              if (active_tooltip_) {
+                active_tooltip_->render(current_buffer_);
+              }
+              if (profiler_hud_) {
+                profiler_hud_->render(current_buffer_);
+              }
+              current_buffer_.pop_clip();
+            }
+          }
 
-          if (auto cont = std::dynamic_pointer_cast<Container>(root)) {
-            cont->layout();
+          {
+            FrameProfiler::Scope prof(g_frame_profiler,
+                                      FrameProfiler::Phase::Diff);
+            term.render(current_buffer_, previous_buffer_, damage);
           }
 
-          root->render(current_buffer_);
-        }
+          // O(1) buffer swap instead of a full deep copy; remember which
+          // rows this frame touched for the next re-seed
+          current_buffer_.swap(previous_buffer_);
+          reseed_rects_ = std::move(damage);
+          reseed_all_ = false;
+        } else {
+          if (root) {
+            Cell bg_cell;
+            bg_cell.bg_color = Theme::current().background;
+            bg_cell.fg_color = Theme::current().foreground;
+            current_buffer_.clear(bg_cell);
 
-        // Render Dialogs (Overlay)
-        for (auto &d : dialog_stack) {
-          if (d->is_open) d->render(current_buffer_);
-        }
+            root->width = current_buffer_.width();
+            root->height = current_buffer_.height();
+
+            {
+              FrameProfiler::Scope prof(g_frame_profiler,
+                                        FrameProfiler::Phase::Layout);
+              if (auto cont = std::dynamic_pointer_cast<Container>(root)) {
+                cont->layout();
+              }
+            }
+            hit_index_.invalidate();  // Geometry may have moved under the grid
+
+            FrameProfiler::Scope prof(g_frame_profiler,
+                                      FrameProfiler::Phase::Render);
+            root->render(current_buffer_);
+          }
+
+          {
+            FrameProfiler::Scope prof(g_frame_profiler,
+                                      FrameProfiler::Phase::Render);
+
+            // Render Dialogs (Overlay)
+            for (auto &d : dialog_stack) {
+              if (d->is_open) d->render(current_buffer_);
+            }
+
+            // Render Automatic Tooltip (Top-most)
+            if (active_tooltip_) {
+              active_tooltip_->render(current_buffer_);
+            }
+
+            // Render Profiler Overlay (Top-most)
+            if (profiler_hud_) {
+              profiler_hud_->render(current_buffer_);
+            }
+          }
+
+          // Handle force redraw
+          {
+            FrameProfiler::Scope prof(g_frame_profiler,
+                                      FrameProfiler::Phase::Diff);
+            term.render(current_buffer_, previous_buffer_);
+          }
+          g_full_damage = false;
 
-        // Render Automatic Tooltip (Top-most)
-        if (active_tooltip_) {
-          active_tooltip_->render(current_buffer_);
+          // A full render rewrote every row, so the swapped-out buffer is
+          // entirely stale and must be fully re-seeded before the next
+          // partial frame
+          current_buffer_.swap(previous_buffer_);
+          reseed_rects_.clear();
+          reseed_all_ = true;
         }
 
-        // Handle force redraw
-        term.render(current_buffer_, previous_buffer_);
-        previous_buffer_ = current_buffer_;
+        g_damage_rects.clear();
         needs_render = false;
+
+        g_frame_profiler.end_frame(partial);
+
+        // The overlay shows the frame just measured, so its region must be
+        // repainted whenever the next frame happens
+        if (profiler_hud_ && profiler_hud_->visible) {
+          profiler_hud_->mark_dirty();
+        }
       }
 
       // Wait for event with varying timeout, then batch process up to 50 events
       int max_batch = 50;
       int time_left = min_wait_ms;
+      Event deferred;  // Overflow from mouse-motion coalescing below
 
       while (max_batch-- > 0) {
-        Event event = term.readEvent(time_left);
+        Event event;
+        if (deferred.type != EventType::None) {
+          event = deferred;
+          deferred = Event{};
+        } else {
+          event = term.readEvent(time_left);
+        }
 
         if (event.type == EventType::None) {
           break;  // No more events (or timeout)
         }
 
-        // Wakeup event: just trigger a redraw, don't dispatch
+        // Wakeup event: just trigger a redraw, don't dispatch.
+        // Damage reported by mark_dirty() (e.g. from post() callbacks)
+        // stays partial; everything below forces a full redraw.
         if (event.type == EventType::Wakeup) {
           needs_render = true;
           break;
         }
 
+        // Pointer motion floods the queue during drags, but only the newest
+        // position can affect this frame: collapse runs of move/drag events
+        // with the same button state before paying for dispatch. A
+        // non-coalescable event read while peeking ahead is kept for the next
+        // iteration.
+        if (event.is_mouse_event() && event.mouse_motion() &&
+            !event.mouse_wheel()) {
+          while (max_batch > 0) {
+            Event next = term.readEvent(0);
+            if (next.type == EventType::None) break;
+            if (next.is_mouse_event() && next.mouse_motion() &&
+                !next.mouse_wheel() && next.button == event.button &&
+                next.shift == event.shift && next.ctrl == event.ctrl &&
+                next.alt == event.alt) {
+              event = next;  // Drop the stale position
+              --max_batch;
+              continue;
+            }
+            deferred = next;
+            break;
+          }
+        }
+
+        // Input dispatch can change arbitrary widget state and geometry,
+        // so fall back to a full-tree render for this frame
+        Widget::mark_all_dirty();
+
         // Subsequent reads should be instant (check buffer)
         time_left = 0;
 
@@ -15445,7 +19005,7 @@ class App {
 
         // 2. Focused Widget Dispatch (Keys only)
         bool consumed = false;
-        if ((event.is_key_event() || event.type == EventType::Paste) &&
+        if ((event.is_key_event() || event.is_text_event()) &&
             focused_widget_) {
           consumed = focused_widget_->on_event(event);
           if (consumed) {
@@ -15475,7 +19035,7 @@ class App {
 
         // 5. Root Dispatch (Spatial or unhandled keys)
         if (event.is_mouse_event() || event.is_key_event() ||
-            event.type == EventType::Paste) {
+            event.is_text_event()) {
           if (event.is_mouse_event()) {
             // 5a. Dispatch ALL mouse events to active_tooltip_ if inside bounds
             // This handles clicks, drags, and releases for tooltip text
@@ -15603,9 +19163,23 @@ class App {
             }
 
             if (!found_in_dialog && root) {
-              target_widget = find_widget_at(root, event.x, event.y, false, 0,
-                                             0, current_buffer_.width(),
-                                             current_buffer_.height());
+              // Hover resolution is the hot path during drags: use the
+              // screen-space hit index (rebuilt lazily after layout) instead
+              // of a recursive containment walk through every container
+              if (!hit_index_.valid) {
+                hit_index_.build(root, current_buffer_.width(),
+                                 current_buffer_.height());
+              }
+              target_widget = hit_index_.candidate(event.x, event.y);
+              // The grid stores the topmost rect owner; widgets with a
+              // custom hit_test (e.g. transparent overlays) can reject the
+              // cell, in which case fall back to the exact recursive search
+              if (target_widget &&
+                  !target_widget->hit_test(event.x, event.y)) {
+                target_widget = find_widget_at(root, event.x, event.y, false,
+                                               0, 0, current_buffer_.width(),
+                                               current_buffer_.height());
+              }
             }
 
             // Update Hover State
@@ -15732,22 +19306,67 @@ class App {
         }
       }  // End batch loop
     }
+
+    // Presented frames must reach the terminal before any teardown bytes
+    term.wait_output_drained();
   }
 
  private:
   struct Timer {
     int id;
     std::chrono::milliseconds interval;
-    std::chrono::steady_clock::time_point last_fire;
+    std::chrono::steady_clock::time_point next_fire;
     std::function<void()> callback;
+    bool active = true;  ///< Cleared by remove_timer(); reaped lazily
+  };
+
+  /// @brief Min-heap entry keyed by the next scheduled fire time. Entries
+  /// are never removed in place: cancelling or rescheduling a timer leaves
+  /// a stale entry behind that is discarded when it reaches the top.
+  struct TimerDeadline {
+    std::chrono::steady_clock::time_point when;
+    int id;
+    bool operator>(const TimerDeadline &other) const {
+      return when > other.when;
+    }
   };
 
-  std::vector<Timer> timers_;
+  std::unordered_map<int, Timer> timers_;
+  std::priority_queue<TimerDeadline, std::vector<TimerDeadline>,
+                      std::greater<TimerDeadline>>
+      timer_heap_;
   int next_timer_id_ = 1;
+  int timer_coalesce_ms_ = 0;
+
+  /// @brief Node in the lock-free multi-producer single-consumer queue
+  /// behind post()/post_many(). Each node carries one submission: a single
+  /// callback from post() or a whole producer-side batch from post_many().
+  struct PostNode {
+    std::vector<std::function<void()>> batch;
+    PostNode *next = nullptr;
+  };
 
-  // Thread-safe callback queue for post()
-  std::mutex post_mutex_;
-  std::vector<std::function<void()>> posted_callbacks_;
+  // Producers CAS nodes onto this head; the UI thread takes everything
+  // with one exchange in the drain loop
+  std::atomic<PostNode *> post_head_{nullptr};
+
+  /// @brief Push one node onto the post queue (any thread)
+  /// @return true when the queue was empty, i.e. this producer made the
+  /// empty-to-nonempty transition and owns the single wakeup signal
+  bool push_post_node(PostNode *node) {
+    // The old head lives in a local: once the CAS publishes the node the
+    // consumer may take it and rewrite its next pointer at any moment, so
+    // the node must not be touched again. acq_rel on success so each push
+    // also acquires the previous pusher's store, keeping the whole chain
+    // visible to the consumer's exchange.
+    PostNode *prev = post_head_.load(std::memory_order_relaxed);
+    do {
+      node->next = prev;
+    } while (!post_head_.compare_exchange_weak(prev, node,
+                                               std::memory_order_acq_rel,
+                                               std::memory_order_relaxed));
+    return prev == nullptr;
+  }
 
   std::shared_ptr<Widget> focused_widget_;
 
@@ -15755,9 +19374,105 @@ class App {
   std::shared_ptr<Widget> hovered_widget_;
   std::shared_ptr<Tooltip> active_tooltip_;
 
+  // Frame profiler overlay (lives outside the widget tree, like the tooltip)
+  std::shared_ptr<ProfilerHUD> profiler_hud_;
+
+  // Presentation settings requested before run(); empty keeps the
+  // backend's defaults
+  std::optional<ColorMode> color_mode_override_;
+  std::optional<bool> sync_output_override_;
+  std::optional<bool> async_output_override_;
+
   Buffer current_buffer_;
   Buffer previous_buffer_;
 
+  // Double-buffering bookkeeping: rows the last frame changed, which must
+  // be copied into the swapped-in back buffer before a partial redraw
+  std::vector<Rect> reseed_rects_;
+  bool reseed_all_ = true;
+
+  /// @brief Clamp damage rects to the buffer and merge overlapping ones so
+  /// the partial render path never emits a cell twice.
+  static std::vector<Rect> merge_damage(const std::vector<Rect> &rects,
+                                        int width, int height) {
+    std::vector<Rect> merged;
+    for (Rect r : rects) {
+      r = r.intersect({0, 0, width, height});
+      if (r.width <= 0 || r.height <= 0) continue;
+
+      bool absorbed = false;
+      for (auto &m : merged) {
+        // Union with an existing rect if they overlap
+        if (r.x < m.x + m.width && m.x < r.x + r.width &&
+            r.y < m.y + m.height && m.y < r.y + r.height) {
+          int nx = std::min(m.x, r.x);
+          int ny = std::min(m.y, r.y);
+          int nx2 = std::max(m.x + m.width, r.x + r.width);
+          int ny2 = std::max(m.y + m.height, r.y + r.height);
+          m = {nx, ny, nx2 - nx, ny2 - ny};
+          absorbed = true;
+          break;
+        }
+      }
+      if (!absorbed) merged.push_back(r);
+    }
+    return merged;
+  }
+
+  /// @brief Screen-space hit index for hover resolution: a cell grid mapping
+  /// each position to the topmost widget covering it, rebuilt lazily after
+  /// layout so pointer motion resolves with one array read instead of a
+  /// recursive containment walk through every container.
+  struct HitIndex {
+    int width = 0;
+    int height = 0;
+    bool valid = false;
+    std::vector<int> cells;  ///< Index into entries per cell, -1 = empty
+    std::vector<std::shared_ptr<Widget>> entries;
+
+    void invalidate() { valid = false; }
+
+    void build(const std::shared_ptr<Widget> &root, int w, int h) {
+      width = w;
+      height = h;
+      cells.assign((size_t)w * (size_t)h, -1);
+      entries.clear();
+      if (root) paint(root, {0, 0, w, h});
+      valid = true;
+    }
+
+    /// @brief Topmost widget whose laid-out rect covers (x, y), or null.
+    /// Callers must confirm with hit_test(): the grid only knows rects.
+    std::shared_ptr<Widget> candidate(int x, int y) const {
+      if (x < 0 || x >= width || y < 0 || y >= height) return nullptr;
+      int idx = cells[(size_t)y * (size_t)width + (size_t)x];
+      return idx < 0 ? nullptr : entries[idx];
+    }
+
+   private:
+    void paint(const std::shared_ptr<Widget> &widget, Rect clip) {
+      if (!widget || !widget->visible) return;
+      Rect r = clip.intersect(
+          {widget->x, widget->y, widget->width, widget->height});
+      if (r.width <= 0 || r.height <= 0) return;
+
+      int idx = (int)entries.size();
+      entries.push_back(widget);
+      for (int py = r.y; py < r.y + r.height; ++py) {
+        int row = py * width;
+        for (int px = r.x; px < r.x + r.width; ++px) cells[row + px] = idx;
+      }
+
+      // Children paint over their parent in declaration order, so the last
+      // child ends up on top - same z-order as the reverse-iteration search
+      // in find_widget_at()
+      if (auto cont = std::dynamic_pointer_cast<Container>(widget)) {
+        for (auto &child : cont->get_children()) paint(child, r);
+      }
+    }
+  };
+  HitIndex hit_index_;
+
   void collect_focusables(std::shared_ptr<Widget> widget,
                           std::vector<std::shared_ptr<Widget>> &out) {
     if (!widget) return;
@@ -16259,6 +19974,176 @@ class Spinner : public Widget {
                      effective_bg);
   }
 };
+
+// FileExplorer scan implementation. Defined out of line because background
+// mode needs App (post/timers) and Spinner, both declared after the widget.
+
+inline FileExplorer::~FileExplorer() {
+  scan_state_->cancelled = true;
+  stop_spinner_timer();
+}
+
+inline void FileExplorer::refresh() {
+  scan_state_->cancelled = true;  // Orphan any in-flight scans
+  scan_state_ = std::make_shared<ScanState>();
+  scanned_dirs_.clear();
+  scanning_dirs_.clear();
+  stop_spinner_timer();
+
+  tree_view_->root_nodes.clear();
+  tree_view_->clear_children();
+
+  std::filesystem::path p = std::filesystem::absolute(root_path_);
+  TreeNode root;
+  root.label = p.filename().string();
+  if (root.label.empty()) root.label = root_path_;
+  root.user_data = p.string();
+  root.expanded = true;
+  if (app_) {
+    root.id = "dir";  // Children stream in from the worker thread
+  } else {
+    populate_node_recursive(root, p);
+  }
+  tree_view_->root_nodes.push_back(root);
+
+  tree_view_->on_submit = [this](TreeNode *node) {
+    if (!node || node->user_data.empty()) return;
+    if (node->id == "dir" || std::filesystem::is_directory(node->user_data)) {
+      // Unscanned directories are leaves until their first expand
+      if (app_ && !scanned_dirs_.count(node->user_data)) {
+        start_scan(node->user_data);
+      }
+    } else if (on_file_selected) {
+      on_file_selected(node->user_data);
+    }
+  };
+
+  tree_view_->refresh();
+
+  if (app_) start_scan(p.string());
+}
+
+inline void FileExplorer::start_scan(const std::string &dir_path) {
+  if (!app_ || scanning_dirs_.count(dir_path) || scanned_dirs_.count(dir_path))
+    return;
+
+  TreeNode *dir = find_node_by_path(dir_path);
+  if (!dir) return;
+  scanning_dirs_[dir_path] = dir->icon;  // Remember icon to restore when done
+
+  if (spinner_timer_.id == -1) {
+    int interval = (int)Spinner::StyleBrailleSpin().interval.count();
+    spinner_timer_ =
+        app_->add_timer(interval, [this]() { advance_spinners(); });
+  }
+
+  auto state = scan_state_;
+  App *app = app_;
+  int batch_size = scan_batch_size;
+  std::thread([this, state, app, dir_path, batch_size]() {
+    std::vector<TreeNode> pending;
+    auto flush = [&](bool done) {
+      if (state->cancelled) return;
+      std::vector<TreeNode> out;
+      out.swap(pending);
+      app->post([this, state, dir_path, out, done]() mutable {
+        if (state->cancelled) return;
+        apply_scan_batch(dir_path, std::move(out), done);
+      });
+    };
+
+    try {
+      for (const auto &entry : std::filesystem::directory_iterator(dir_path)) {
+        if (state->cancelled) return;
+        TreeNode child;
+        child.label = entry.path().filename().string();
+        child.user_data = entry.path().string();
+        std::error_code ec;
+        if (entry.is_directory(ec)) {
+          child.id = "dir";
+          child.icon = "\U0001F4C1";  // Folder icon
+        } else {
+          child.icon = "\U0001F4C4";  // File icon
+        }
+        pending.push_back(std::move(child));
+        if ((int)pending.size() >= batch_size) flush(false);
+      }
+    } catch (...) {
+    }
+    flush(true);
+  }).detach();
+}
+
+inline void FileExplorer::apply_scan_batch(const std::string &dir_path,
+                                           std::vector<TreeNode> entries,
+                                           bool done) {
+  TreeNode *dir = find_node_by_path(dir_path);
+  if (!dir) {
+    scanning_dirs_.erase(dir_path);
+    return;
+  }
+
+  // dir->children is a by-value vector: appending streamed rows can
+  // reallocate it and the completion sort below reorders it, either of
+  // which would dangle a selection pointing at one of its elements (the
+  // user can select a row between batches). Remember the selected path,
+  // drop the raw pointer, and re-resolve it afterwards.
+  std::string selected_path;
+  bool reselect = false;
+  if (TreeNode *selected = tree_view_->get_selected_node()) {
+    for (auto &c : dir->children) {
+      if (&c == selected) {
+        selected_path = c.user_data;
+        reselect = true;
+        tree_view_->rebind_selection(nullptr);
+        break;
+      }
+    }
+  }
+
+  for (auto &e : entries) dir->children.push_back(std::move(e));
+  dir->expanded = true;  // Show rows as they stream in
+
+  if (done) {
+    auto saved = scanning_dirs_.find(dir_path);
+    if (saved != scanning_dirs_.end()) {
+      dir->icon = saved->second;
+      scanning_dirs_.erase(saved);
+    }
+    scanned_dirs_.insert(dir_path);
+    sort_entries(dir->children);
+    // Posted callbacks are safe to remove timers from (unlike timer
+    // callbacks, which fire while the timer list is being iterated)
+    if (scanning_dirs_.empty()) stop_spinner_timer();
+  }
+
+  if (reselect) {
+    tree_view_->rebind_selection(find_node_by_path(selected_path));
+  }
+
+  tree_view_->refresh();
+}
+
+inline void FileExplorer::advance_spinners() {
+  if (scanning_dirs_.empty()) return;  // Timer removed on next batch apply
+
+  static const Spinner::Style style = Spinner::StyleBrailleSpin();
+  spinner_frame_ = (spinner_frame_ + 1) % style.frames.size();
+  for (auto &entry : scanning_dirs_) {
+    if (TreeNode *dir = find_node_by_path(entry.first)) {
+      dir->icon = style.frames[spinner_frame_];
+    }
+  }
+  tree_view_->refresh();
+}
+
+inline void FileExplorer::stop_spinner_timer() {
+  if (app_ && spinner_timer_.id != -1) {
+    app_->remove_timer(spinner_timer_);
+  }
+  spinner_timer_ = {-1};
+}
+
 inline bool MenuDialog::on_event(const Event &event) {
   if (!is_open) return false;
 